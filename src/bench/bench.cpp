@@ -0,0 +1,477 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "../s21_cholesky.h"
+#include "../s21_matrix_batch.h"
+#include "../s21_matrix_io.h"
+#include "../s21_matrix_oop.h"
+#include "../s21_solve.h"
+#include "../s21_sparse_matrix.h"
+#include "../s21_strassen.h"
+#include "../s21_tiled_matrix.h"
+
+/**
+ * Замеры скорости операций S21Matrix (Google Benchmark).
+ *
+ * Для каждой операции кроме времени на одну операцию выводятся:
+ *   flops        - операций с плавающей точкой в секунду (по стандартной
+ *                  оценке сложности алгоритма), в консоли 5.1G/s -
+ *                  это 5.1 GFLOP/s;
+ *   bytes        - байт прочитано и записано в секунду, для операций,
+ *                  ограниченных памятью;
+ *   alloc_bytes  - сколько байт буферов матриц выделяет одна операция
+ *                  (по s21::GetAllocationStats).
+ *
+ * Размеры квадратных матриц - степени двойки от 2 до 4096. Формы:
+ * square - [n x n], tall - [n x 32], wide - [32 x n]. Суффикс Float -
+ * тот же замер для S21MatrixF. Batch - kBatchCount матриц [n x n] одним
+ * набором S21MatrixBatch, Loop - те же матрицы по одной через S21Matrix.
+ * Sparse - S21SparseMatrix [n x n] с kSparseNonZeros ненулевыми в строке.
+ * MulMatrixStrassen/n/x - [n x n] * [n x n] по Штрассену с crossover x,
+ * сравнивается с BM_MulMatrix/n/n/n. LoadMatrix и MapMatrix - чтение
+ * [n x n] из файла s21::Save: копией в S21Matrix и отображением в память.
+ * Solve/n/method - s21::Solve для [n x n] и правой части [n x kSolveColumns]:
+ * method 1 - LU, 4 - Холецкий для A^T * A + n * E.
+ * TiledMulMatrix/n/t - произведение S21TiledMatrix [n x n] с плитками
+ * t x t и бюджетом памяти kTiledBudget, с чтением плиток с диска.
+ *
+ * make bench       - вывод в консоль;
+ * make bench_json  - дополнительно bench.json для сравнения коммитов
+ *                    (например, tools/compare.py из Google Benchmark).
+ */
+namespace {
+constexpr int kMinSize = 2;
+constexpr int kMaxSize = 4096;
+constexpr int kSkinny = 32;
+constexpr std::size_t kBatchCount = 1 << 14;
+constexpr int kSparseNonZeros = 8;
+
+// Случайная матрица с диагональным преобладанием - заведомо невырожденная
+template <typename T = double>
+S21MatrixT<T> RandomMatrix(int rows, int cols, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<T> dist(-1, 1);
+  S21MatrixT<T> res(rows, cols);
+  T* data = res.Data();
+  for (std::int64_t i = 0; i < static_cast<std::int64_t>(rows) * cols; ++i) {
+    data[i] = dist(gen);
+  }
+  for (int i = 0; i < rows && i < cols; ++i) {
+    res(i, i) += cols;
+  }
+  return res;
+}
+
+/**
+ * Замер body в цикле state с общими счётчиками: flops и прочитанные/
+ * записанные байты на одну операцию и выделенные за операцию байты.
+ */
+template <typename Body>
+void Measure(benchmark::State& state, double flops, double bytes,
+             const Body& body) {
+  const std::size_t start = s21::GetAllocationStats().bytes;
+  for (auto _ : state) {
+    body();
+  }
+  const double iterations = static_cast<double>(state.iterations());
+  const std::size_t allocated = s21::GetAllocationStats().bytes - start;
+  if (flops > 0) {
+    state.counters["flops"] = benchmark::Counter(
+        flops, benchmark::Counter::kIsIterationInvariantRate);
+  }
+  if (bytes > 0) {
+    state.counters["bytes"] = benchmark::Counter(
+        bytes, benchmark::Counter::kIsIterationInvariantRate,
+        benchmark::Counter::OneK::kIs1024);
+  }
+  state.counters["alloc_bytes"] =
+      benchmark::Counter(static_cast<double>(allocated) / iterations);
+}
+
+// Временный каталог для файлов замера, удаляется вместе с содержимым
+class TempDir final {
+ private:
+  std::filesystem::path path_;
+
+ public:
+  TempDir() {
+    std::random_device random;
+    const std::filesystem::path base =
+        std::filesystem::temp_directory_path();
+    do {
+      path_ = base / ("s21_bench_" + std::to_string(random()));
+    } while (!std::filesystem::create_directory(path_));
+  }
+  TempDir(const TempDir&) = delete;
+  TempDir& operator=(const TempDir&) = delete;
+  ~TempDir() {
+    std::error_code error;
+    std::filesystem::remove_all(path_, error);
+  }
+
+  std::string File(const std::string& name) const {
+    return (path_ / name).string();
+  }
+};
+
+void SquareSizes(benchmark::internal::Benchmark* bench) {
+  for (int n = kMinSize; n <= kMaxSize; n *= 2) {
+    bench->Args({n, n});
+  }
+}
+
+// Квадратные, высокие и широкие матрицы
+void AllShapes(benchmark::internal::Benchmark* bench) {
+  SquareSizes(bench);
+  for (int n = 2 * kSkinny; n <= kMaxSize * 4; n *= 4) {
+    bench->Args({n, kSkinny});
+    bench->Args({kSkinny, n});
+  }
+}
+
+// Произведение [m x k] * [k x n]: квадратные, высокая на узкую,
+// широкая на высокую и "внешнее" произведение
+void MulShapes(benchmark::internal::Benchmark* bench) {
+  for (int n = kMinSize; n <= kMaxSize; n *= 2) {
+    bench->Args({n, n, n});
+  }
+  for (int n = 2 * kSkinny; n <= kMaxSize * 4; n *= 4) {
+    bench->Args({n, kSkinny, kSkinny});
+    bench->Args({kSkinny, n, kSkinny});
+    bench->Args({n, kSkinny, n / 4});
+  }
+}
+
+template <typename T>
+void SumMatrix(benchmark::State& state) {
+  const int rows = static_cast<int>(state.range(0));
+  const int cols = static_cast<int>(state.range(1));
+  S21MatrixT<T> a = RandomMatrix<T>(rows, cols, 1);
+  const S21MatrixT<T> b = RandomMatrix<T>(rows, cols, 2);
+  const double count = static_cast<double>(rows) * cols;
+  Measure(state, count, 3 * count * sizeof(T), [&] {
+    a.SumMatrix(b);
+    benchmark::DoNotOptimize(a.Data());
+    benchmark::ClobberMemory();
+  });
+}
+
+void BM_SumMatrix(benchmark::State& state) { SumMatrix<double>(state); }
+BENCHMARK(BM_SumMatrix)->Apply(AllShapes);
+
+void BM_SumMatrixFloat(benchmark::State& state) { SumMatrix<float>(state); }
+BENCHMARK(BM_SumMatrixFloat)->Apply(AllShapes);
+
+template <typename T>
+void MulMatrix(benchmark::State& state) {
+  const int m = static_cast<int>(state.range(0));
+  const int k = static_cast<int>(state.range(1));
+  const int n = static_cast<int>(state.range(2));
+  const S21MatrixT<T> a = RandomMatrix<T>(m, k, 3);
+  const S21MatrixT<T> b = RandomMatrix<T>(k, n, 4);
+  Measure(state, 2.0 * m * n * k, 0, [&] {
+    S21MatrixT<T> res = s21::Multiply(a, b);
+    benchmark::DoNotOptimize(res.Data());
+  });
+}
+
+void BM_MulMatrix(benchmark::State& state) { MulMatrix<double>(state); }
+BENCHMARK(BM_MulMatrix)->Apply(MulShapes)->Unit(benchmark::kMicrosecond);
+
+void BM_MulMatrixFloat(benchmark::State& state) { MulMatrix<float>(state); }
+BENCHMARK(BM_MulMatrixFloat)->Apply(MulShapes)->Unit(benchmark::kMicrosecond);
+
+void StrassenShapes(benchmark::internal::Benchmark* bench) {
+  for (int n = 512; n <= kMaxSize; n *= 2) {
+    for (int crossover = 128; crossover <= 512; crossover *= 2) {
+      bench->Args({n, crossover});
+    }
+  }
+}
+
+void BM_MulMatrixStrassen(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  const int crossover = static_cast<int>(state.range(1));
+  const S21Matrix a = RandomMatrix(n, n, 3), b = RandomMatrix(n, n, 4);
+  // Скорость в пересчёте на классические 2n^3 операций
+  Measure(state, 2.0 * n * n * n, 0, [&] {
+    S21Matrix res = s21::MultiplyStrassen(a, b, crossover);
+    benchmark::DoNotOptimize(res.Data());
+  });
+}
+BENCHMARK(BM_MulMatrixStrassen)
+    ->Apply(StrassenShapes)
+    ->Unit(benchmark::kMillisecond);
+
+void BM_Transpose(benchmark::State& state) {
+  const int rows = static_cast<int>(state.range(0));
+  const int cols = static_cast<int>(state.range(1));
+  S21Matrix a = RandomMatrix(rows, cols, 5);
+  Measure(state, 0, 2.0 * rows * cols * sizeof(double), [&] {
+    S21Matrix res = a.Transpose();
+    benchmark::DoNotOptimize(res.Data());
+  });
+}
+BENCHMARK(BM_Transpose)->Apply(AllShapes);
+
+void BM_Determinant(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  const S21Matrix a = RandomMatrix(n, n, 6);
+  Measure(state, 2.0 / 3.0 * n * n * n, 0, [&] {
+    benchmark::DoNotOptimize(a.Determinant());
+  });
+}
+BENCHMARK(BM_Determinant)->Apply(SquareSizes)->Unit(benchmark::kMicrosecond);
+
+void BM_CalcComplements(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  const S21Matrix a = RandomMatrix(n, n, 7);
+  Measure(state, 2.0 * n * n * n, 0, [&] {
+    S21Matrix res = a.CalcComplements();
+    benchmark::DoNotOptimize(res.Data());
+  });
+}
+BENCHMARK(BM_CalcComplements)
+    ->Apply(SquareSizes)
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_InverseMatrix(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  const S21Matrix a = RandomMatrix(n, n, 8);
+  Measure(state, 2.0 * n * n * n, 0, [&] {
+    S21Matrix res = a.InverseMatrix();
+    benchmark::DoNotOptimize(res.Data());
+  });
+}
+BENCHMARK(BM_InverseMatrix)->Apply(SquareSizes)->Unit(benchmark::kMicrosecond);
+
+// Сравнивать с BM_Determinant: то же на LU вдвое дороже
+void BM_Cholesky(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a = RandomMatrix(n, n, 22);
+  a = a.Transpose() * a;
+  for (int i = 0; i < n; ++i) {
+    a(i, i) += n;
+  }
+  Measure(state, 1.0 / 3.0 * n * n * n, 0, [&] {
+    S21Cholesky res(a);
+    benchmark::DoNotOptimize(res.IsPositiveDefinite());
+  });
+}
+BENCHMARK(BM_Cholesky)->Apply(SquareSizes)->Unit(benchmark::kMicrosecond);
+
+constexpr int kSolveColumns = 64;
+
+void SolveShapes(benchmark::internal::Benchmark* bench) {
+  for (int n = 64; n <= 2048; n *= 4) {
+    for (auto method : {s21::SolveMethod::kGeneral,
+                        s21::SolveMethod::kPositiveDefinite}) {
+      bench->Args({n, static_cast<int>(method)});
+    }
+  }
+}
+
+void BM_Solve(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  const auto method = static_cast<s21::SolveMethod>(state.range(1));
+  S21Matrix a = RandomMatrix(n, n, 20);
+  if (method == s21::SolveMethod::kPositiveDefinite) {
+    a = a.Transpose() * a;
+    for (int i = 0; i < n; ++i) {
+      a(i, i) += n;
+    }
+  }
+  const S21Matrix b = RandomMatrix(n, kSolveColumns, 21);
+  // Разложение LU 2/3 n^3 (Холецкого - 1/3 n^3) и 2 n^2 на столбец
+  const double factor = method == s21::SolveMethod::kGeneral ? 2.0 : 1.0;
+  const double flops =
+      factor / 3.0 * n * n * n + 2.0 * n * n * kSolveColumns;
+  Measure(state, flops, 0, [&] {
+    S21Matrix res = s21::Solve(a, b, method);
+    benchmark::DoNotOptimize(res.Data());
+  });
+}
+BENCHMARK(BM_Solve)->Apply(SolveShapes)->Unit(benchmark::kMicrosecond);
+
+void BatchSizes(benchmark::internal::Benchmark* bench) {
+  for (int n = 2; n <= 8; n *= 2) {
+    bench->Arg(n);
+  }
+}
+
+S21MatrixBatch RandomBatch(int n, unsigned seed) {
+  S21MatrixBatch res(kBatchCount, n, n);
+  for (std::size_t i = 0; i < kBatchCount; ++i) {
+    res.Set(i, RandomMatrix(n, n, seed + static_cast<unsigned>(i)));
+  }
+  return res;
+}
+
+std::vector<S21Matrix> RandomMatrices(int n, unsigned seed) {
+  std::vector<S21Matrix> res;
+  for (std::size_t i = 0; i < kBatchCount; ++i) {
+    res.push_back(RandomMatrix(n, n, seed + static_cast<unsigned>(i)));
+  }
+  return res;
+}
+
+void BM_BatchMulMatrix(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  const S21MatrixBatch a = RandomBatch(n, 9), b = RandomBatch(n, 10);
+  Measure(state, 2.0 * n * n * n * kBatchCount, 0, [&] {
+    S21MatrixBatch res = s21::BatchMulMatrix(a, b);
+    benchmark::DoNotOptimize(res.Data());
+  });
+}
+BENCHMARK(BM_BatchMulMatrix)->Apply(BatchSizes)->Unit(benchmark::kMicrosecond);
+
+void BM_LoopMulMatrix(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  const std::vector<S21Matrix> a = RandomMatrices(n, 9);
+  const std::vector<S21Matrix> b = RandomMatrices(n, 10);
+  Measure(state, 2.0 * n * n * n * kBatchCount, 0, [&] {
+    for (std::size_t i = 0; i < kBatchCount; ++i) {
+      S21Matrix res = a[i] * b[i];
+      benchmark::DoNotOptimize(res.Data());
+    }
+  });
+}
+BENCHMARK(BM_LoopMulMatrix)->Apply(BatchSizes)->Unit(benchmark::kMicrosecond);
+
+void BM_BatchInverse(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  const S21MatrixBatch a = RandomBatch(n, 11);
+  Measure(state, 2.0 * n * n * n * kBatchCount, 0, [&] {
+    S21MatrixBatch res = s21::BatchInverse(a);
+    benchmark::DoNotOptimize(res.Data());
+  });
+}
+BENCHMARK(BM_BatchInverse)->Apply(BatchSizes)->Unit(benchmark::kMicrosecond);
+
+void BM_LoopInverse(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  const std::vector<S21Matrix> a = RandomMatrices(n, 11);
+  Measure(state, 2.0 * n * n * n * kBatchCount, 0, [&] {
+    for (const S21Matrix& m : a) {
+      S21Matrix res = m.InverseMatrix();
+      benchmark::DoNotOptimize(res.Data());
+    }
+  });
+}
+BENCHMARK(BM_LoopInverse)->Apply(BatchSizes)->Unit(benchmark::kMicrosecond);
+
+S21SparseMatrix RandomSparse(int n, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> col(0, n - 1);
+  std::uniform_real_distribution<double> value(-1, 1);
+  std::vector<S21Triplet> triplets;
+  for (int i = 0; i < n; ++i) {
+    for (int k = 0; k < kSparseNonZeros; ++k) {
+      triplets.push_back({i, col(gen), value(gen)});
+    }
+  }
+  return S21SparseMatrix::FromTriplets(n, n, triplets);
+}
+
+void SparseSizes(benchmark::internal::Benchmark* bench) {
+  for (int n = 1024; n <= 65536; n *= 8) {
+    bench->Arg(n);
+  }
+}
+
+void BM_SparseMulVector(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  const S21SparseMatrix a = RandomSparse(n, 12);
+  const std::vector<double> x(n, 1.0);
+  Measure(state, 2.0 * a.GetNonZeros(), 0, [&] {
+    std::vector<double> y = a * x;
+    benchmark::DoNotOptimize(y.data());
+  });
+}
+BENCHMARK(BM_SparseMulVector)->Apply(SparseSizes);
+
+void BM_SparseMulMatrix(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  const S21SparseMatrix a = RandomSparse(n, 13), b = RandomSparse(n, 14);
+  Measure(state, 2.0 * a.GetNonZeros() * kSparseNonZeros, 0, [&] {
+    S21SparseMatrix res = a * b;
+    benchmark::DoNotOptimize(res.Values().data());
+  });
+}
+BENCHMARK(BM_SparseMulMatrix)
+    ->Apply(SparseSizes)
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_SparseMulDense(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  const S21SparseMatrix a = RandomSparse(n, 15);
+  const S21Matrix b = RandomMatrix(n, kSkinny, 16);
+  Measure(state, 2.0 * a.GetNonZeros() * kSkinny, 0, [&] {
+    S21Matrix res = a * b;
+    benchmark::DoNotOptimize(res.Data());
+  });
+}
+BENCHMARK(BM_SparseMulDense)
+    ->Apply(SparseSizes)
+    ->Unit(benchmark::kMicrosecond);
+
+void IoSizes(benchmark::internal::Benchmark* bench) {
+  for (int n = 256; n <= kMaxSize; n *= 4) {
+    bench->Arg(n);
+  }
+}
+
+void BM_LoadMatrix(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  const TempDir dir;
+  const std::string path = dir.File("bench.s21m");
+  s21::Save(RandomMatrix(n, n, 17), path);
+  Measure(state, 0, 1.0 * n * n * sizeof(double), [&] {
+    S21Matrix res = s21::Load<double>(path);
+    benchmark::DoNotOptimize(res.Data());
+  });
+}
+BENCHMARK(BM_LoadMatrix)->Apply(IoSizes)->Unit(benchmark::kMicrosecond);
+
+// Открытие без чтения данных: время не зависит от размера файла
+void BM_MapMatrix(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  const TempDir dir;
+  const std::string path = dir.File("bench.s21m");
+  s21::Save(RandomMatrix(n, n, 17), path);
+  Measure(state, 0, 0, [&] {
+    S21MappedMatrix res(path);
+    benchmark::DoNotOptimize(res(n - 1, n - 1));
+  });
+}
+BENCHMARK(BM_MapMatrix)->Apply(IoSizes)->Unit(benchmark::kMicrosecond);
+
+// 40 плиток 256 x 256: блоки C по 4 x 4 плитки
+constexpr std::size_t kTiledBudget = 40 * 256 * 256 * sizeof(double);
+
+void BM_TiledMulMatrix(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  const int tile = static_cast<int>(state.range(1));
+  const TempDir dir;
+  S21TiledMatrix a(dir.File("a.s21t"), n, n, tile);
+  S21TiledMatrix b(dir.File("b.s21t"), n, n, tile);
+  a.SetBlock(0, 0, RandomMatrix(n, n, 18));
+  b.SetBlock(0, 0, RandomMatrix(n, n, 19));
+  Measure(state, 2.0 * n * n * n, 0, [&] {
+    S21TiledMatrix res = a.MulMatrix(b, dir.File("c.s21t"), kTiledBudget);
+    benchmark::DoNotOptimize(res.GetRows());
+  });
+}
+BENCHMARK(BM_TiledMulMatrix)
+    ->Args({1024, 256})
+    ->Args({2048, 256})
+    ->Unit(benchmark::kMillisecond);
+}  // namespace
+
+BENCHMARK_MAIN();
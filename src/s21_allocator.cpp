@@ -0,0 +1,318 @@
+#include "s21_allocator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+namespace s21 {
+/**
+ * @brief Общее состояние арены.
+ * @details refs - одна ссылка от самой области S21MatrixArena плюс по одной
+ * на каждый живой буфер. Состояние и блоки удаляются последней ссылкой,
+ * поэтому буфер может быть освобождён после закрытия области и в другом
+ * потоке. Выделение идёт только в потоке-владельце, блокировки не нужны.
+ */
+struct ArenaState {
+  std::atomic<std::size_t> refs{1};
+  std::vector<char*> blocks;
+  char* cursor = nullptr;
+  char* end = nullptr;
+  std::size_t block_bytes;
+  std::size_t used = 0;
+
+  explicit ArenaState(std::size_t bytes) : block_bytes(bytes) {}
+  ~ArenaState();
+};
+}  // namespace s21
+
+namespace {
+/**
+ * @brief Заголовок перед каждым буфером.
+ * @details Занимает ровно kMatrixAlignment байт, так что данные за ним
+ * остаются выровненными.
+ */
+struct alignas(s21::kMatrixAlignment) BlockHeader {
+  s21::ArenaState* arena;
+  // Номер класса пула (размер блока 1 << size_class) или -1 для кучи
+  int size_class;
+};
+static_assert(sizeof(BlockHeader) == s21::kMatrixAlignment,
+              "Header must keep the buffer aligned");
+
+constexpr int kMinClass = 7;   // 128 байт: заголовок и 8 double
+constexpr int kMaxClass = 16;  // kPoolMaxBytes
+constexpr int kClassCount = kMaxClass - kMinClass + 1;
+static_assert(std::size_t(1) << kMaxClass == s21::kPoolMaxBytes,
+              "Pool classes must cover kPoolMaxBytes");
+// Сколько свободных блоков каждого класса пул потока держит про запас
+constexpr std::size_t kPoolDepth = 16;
+
+// Наибольший запрос AllocateBytes: с выравниванием и заголовком он
+// ещё помещается в size_t
+constexpr std::size_t kMaxRequestBytes =
+    std::numeric_limits<std::size_t>::max() - 2 * s21::kMatrixAlignment;
+
+/**
+ * @brief Счётчики выделений одного потока.
+ * @details Пишет их только сам поток (load и store без атомарного
+ * сложения), каждый набор занимает свою кэш-линию, поэтому потоки не
+ * делят линию при каждом выделении. GetAllocationStats суммирует наборы
+ * живых потоков и итог завершившихся.
+ */
+struct alignas(s21::kMatrixAlignment) ThreadCounters {
+  std::atomic<std::size_t> count{0};
+  std::atomic<std::size_t> bytes{0};
+  std::atomic<std::size_t> heap{0};
+
+  ThreadCounters();
+  ~ThreadCounters();
+
+  static thread_local bool alive;
+};
+
+/**
+ * @brief Список счётчиков живых потоков и итог завершившихся.
+ * @details Блокировка берётся только при запуске и завершении потока и в
+ * GetAllocationStats. Объект не удаляется: рабочие потоки глобального
+ * пула завершаются уже при разрушении статических объектов.
+ */
+struct CounterRegistry {
+  std::mutex mutex;
+  std::vector<ThreadCounters*> live;
+  std::atomic<std::size_t> count{0};
+  std::atomic<std::size_t> bytes{0};
+  std::atomic<std::size_t> heap{0};
+
+  static CounterRegistry& Get() {
+    static CounterRegistry* registry = new CounterRegistry;
+    return *registry;
+  }
+};
+
+ThreadCounters::ThreadCounters() {
+  CounterRegistry& registry = CounterRegistry::Get();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.live.push_back(this);
+}
+
+ThreadCounters::~ThreadCounters() {
+  CounterRegistry& registry = CounterRegistry::Get();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.count += count.load(std::memory_order_relaxed);
+  registry.bytes += bytes.load(std::memory_order_relaxed);
+  registry.heap += heap.load(std::memory_order_relaxed);
+  registry.live.erase(
+      std::find(registry.live.begin(), registry.live.end(), this));
+  alive = false;
+}
+
+thread_local bool ThreadCounters::alive = true;
+thread_local ThreadCounters thread_counters;
+
+void Add(std::atomic<std::size_t>& counter, std::size_t value) noexcept {
+  counter.store(counter.load(std::memory_order_relaxed) + value,
+                std::memory_order_relaxed);
+}
+
+void CountAllocation(std::size_t bytes) noexcept {
+  if (ThreadCounters::alive) {
+    Add(thread_counters.count, 1);
+    Add(thread_counters.bytes, bytes);
+  } else {
+    // Выделение из деструктора другого thread_local после наших счётчиков
+    CounterRegistry& registry = CounterRegistry::Get();
+    registry.count.fetch_add(1, std::memory_order_relaxed);
+    registry.bytes.fetch_add(bytes, std::memory_order_relaxed);
+  }
+}
+
+void* HeapAllocate(std::size_t bytes) {
+  if (ThreadCounters::alive) {
+    Add(thread_counters.heap, 1);
+  } else {
+    CounterRegistry::Get().heap.fetch_add(1, std::memory_order_relaxed);
+  }
+  return ::operator new(bytes, std::align_val_t(s21::kMatrixAlignment));
+}
+
+void HeapFree(void* block) noexcept {
+  ::operator delete(block, std::align_val_t(s21::kMatrixAlignment));
+}
+
+/**
+ * @brief Кэш свободных блоков потока по классам размеров.
+ * @details Блок, освобождённый в другом потоке, попадает в пул того
+ * потока, где освобождён. Сверх kPoolDepth блоки класса возвращаются в
+ * кучу. При завершении потока кэш очищается, а блоки, освобождаемые
+ * после этого, идут сразу в кучу.
+ */
+class ThreadPoolCache {
+ private:
+  std::vector<void*> free_[kClassCount];
+
+ public:
+  ~ThreadPoolCache() {
+    for (auto& list : free_) {
+      for (void* block : list) {
+        HeapFree(block);
+      }
+    }
+    alive = false;
+  }
+
+  void* Take(int size_class) {
+    std::vector<void*>& list = free_[size_class - kMinClass];
+    if (list.empty()) {
+      return HeapAllocate(std::size_t(1) << size_class);
+    }
+    void* block = list.back();
+    list.pop_back();
+    return block;
+  }
+
+  void Give(void* block, int size_class) noexcept {
+    std::vector<void*>& list = free_[size_class - kMinClass];
+    if (list.size() < kPoolDepth) {
+      if (list.capacity() == 0) {
+        try {
+          list.reserve(kPoolDepth);
+        } catch (const std::bad_alloc&) {
+          HeapFree(block);
+          return;
+        }
+      }
+      list.push_back(block);
+    } else {
+      HeapFree(block);
+    }
+  }
+
+  static thread_local bool alive;
+};
+
+thread_local bool ThreadPoolCache::alive = true;
+thread_local ThreadPoolCache pool_cache;
+thread_local s21::ArenaState* current_arena = nullptr;
+
+int SizeClass(std::size_t bytes) noexcept {
+  int size_class = kMinClass;
+  while ((std::size_t(1) << size_class) < bytes) {
+    ++size_class;
+  }
+  return size_class;
+}
+
+std::size_t RoundUp(std::size_t bytes) noexcept {
+  return (bytes + s21::kMatrixAlignment - 1) & ~(s21::kMatrixAlignment - 1);
+}
+
+void* ArenaAllocate(s21::ArenaState* arena, std::size_t bytes) {
+  if (static_cast<std::size_t>(arena->end - arena->cursor) < bytes) {
+    // Крупный запрос получает отдельный блок, текущий блок не бросается
+    std::size_t block = std::max(bytes, arena->block_bytes);
+    arena->blocks.reserve(arena->blocks.size() + 1);
+    char* memory = static_cast<char*>(HeapAllocate(block));
+    arena->blocks.push_back(memory);
+    if (block > arena->block_bytes) {
+      arena->used += bytes;
+      return memory;
+    }
+    arena->cursor = memory;
+    arena->end = memory + block;
+  }
+  void* res = arena->cursor;
+  arena->cursor += bytes;
+  arena->used += bytes;
+  return res;
+}
+
+void ArenaRelease(s21::ArenaState* arena) noexcept {
+  if (arena->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    delete arena;
+  }
+}
+}  // namespace
+
+namespace s21 {
+ArenaState::~ArenaState() {
+  for (char* block : blocks) {
+    HeapFree(block);
+  }
+}
+
+AllocationStats GetAllocationStats() noexcept {
+  CounterRegistry& registry = CounterRegistry::Get();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  AllocationStats res{registry.count.load(std::memory_order_relaxed),
+                      registry.bytes.load(std::memory_order_relaxed),
+                      registry.heap.load(std::memory_order_relaxed)};
+  for (const ThreadCounters* counters : registry.live) {
+    res.count += counters->count.load(std::memory_order_relaxed);
+    res.bytes += counters->bytes.load(std::memory_order_relaxed);
+    res.heap_count += counters->heap.load(std::memory_order_relaxed);
+  }
+  return res;
+}
+
+void* AllocateBytes(std::size_t size) {
+  if (size > kMaxRequestBytes) {
+    throw std::bad_alloc();
+  }
+  CountAllocation(size);
+  const std::size_t bytes = RoundUp(size) + kMatrixAlignment;
+  BlockHeader header{nullptr, -1};
+  void* block = nullptr;
+  if (current_arena != nullptr) {
+    block = ArenaAllocate(current_arena, bytes);
+    current_arena->refs.fetch_add(1, std::memory_order_relaxed);
+    header.arena = current_arena;
+  } else if (bytes <= kPoolMaxBytes && ThreadPoolCache::alive) {
+    header.size_class = SizeClass(bytes);
+    block = pool_cache.Take(header.size_class);
+  } else {
+    block = HeapAllocate(bytes);
+  }
+  new (block) BlockHeader(header);
+  return static_cast<char*>(block) + kMatrixAlignment;
+}
+
+void FreeBuffer(void* buffer) noexcept {
+  if (buffer == nullptr) {
+    return;
+  }
+  void* block = static_cast<char*>(buffer) - kMatrixAlignment;
+  const BlockHeader header = *static_cast<BlockHeader*>(block);
+  if (header.arena != nullptr) {
+    ArenaRelease(header.arena);
+  } else if (header.size_class >= 0 && ThreadPoolCache::alive) {
+    pool_cache.Give(block, header.size_class);
+  } else {
+    HeapFree(block);
+  }
+}
+}  // namespace s21
+
+/**
+ * @brief Открытие области арены.
+ * @param block_bytes размер блока, которыми арена запрашивает память
+ */
+S21MatrixArena::S21MatrixArena(std::size_t block_bytes)
+    : state_(new s21::ArenaState(std::max(RoundUp(block_bytes),
+                                          2 * s21::kMatrixAlignment))),
+      previous_(current_arena) {
+  current_arena = state_;
+}
+
+S21MatrixArena::~S21MatrixArena() {
+  current_arena = previous_;
+  ArenaRelease(state_);
+}
+
+std::size_t S21MatrixArena::GetUsedBytes() const noexcept {
+  return state_->used;
+}
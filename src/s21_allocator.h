@@ -0,0 +1,100 @@
+#ifndef __S21ALLOCATOR_H__
+#define __S21ALLOCATOR_H__
+
+#include <cstddef>
+#include <limits>
+#include <new>
+
+namespace s21 {
+struct ArenaState;
+
+/**
+ * @brief Счётчики выделений буферов матриц за время работы программы.
+ * @details Учитываются только буферы S21Matrix - по ним удобно проверять,
+ * что цепочка операций не создаёт лишних временных матриц. count и bytes -
+ * все запросы буферов, heap_count - сколько раз при этом пришлось
+ * обратиться к глобальному operator new (промах пула, крупный буфер или
+ * новый блок арены). Счётчики ведутся отдельно в каждом потоке и
+ * суммируются при вызове, так что учёт не добавляет выделению общих
+ * атомарных операций.
+ */
+struct AllocationStats {
+  std::size_t count;
+  std::size_t bytes;
+  std::size_t heap_count;
+};
+AllocationStats GetAllocationStats() noexcept;
+
+/**
+ * @brief Буфер на bytes байт, выровненный по kMatrixAlignment.
+ * @details
+ * Источник памяти выбирается так:
+ *   1. открыта S21MatrixArena в этом потоке - память из арены;
+ *   2. небольшой буфер (до kPoolMaxBytes) - из пула потока по классам
+ *      размеров, освобождённые буферы возвращаются в пул и переиспользуются
+ *      без обращения к глобальному аллокатору;
+ *   3. иначе - operator new.
+ * Перед буфером лежит заголовок с источником, поэтому FreeBuffer
+ * корректно освобождает буфер из любого источника и в любом потоке.
+ * Запрос, который вместе с заголовком не помещается в size_t, -
+ * std::bad_alloc.
+ */
+void* AllocateBytes(std::size_t bytes);
+void FreeBuffer(void* buffer) noexcept;
+
+/**
+ * @brief Буфер на count элементов типа T (матрицы любого типа элементов).
+ * @details Если count * sizeof(T) переполняет size_t - std::bad_alloc, а
+ * не буфер меньшего размера.
+ */
+template <typename T = double>
+T* AllocateBuffer(std::size_t count) {
+  if (count > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+    throw std::bad_alloc();
+  }
+  return static_cast<T*>(AllocateBytes(count * sizeof(T)));
+}
+
+// Крупнейший буфер (вместе с заголовком), который берётся из пула потока
+constexpr std::size_t kPoolMaxBytes = 64 * 1024;
+}  // namespace s21
+
+/**
+ * @brief Арена для матриц, созданных в области видимости.
+ * @details
+ * Пока объект арены жив, все буферы S21Matrix, выделяемые в этом потоке,
+ * берутся из её блоков простым сдвигом указателя, без блокировок и без
+ * обращения к глобальному аллокатору. Освобождение отдельных матриц ничего
+ * не стоит, вся память возвращается разом.
+ *
+ *   {
+ *     S21MatrixArena scope;
+ *     S21Matrix res = (A * B + C).InverseMatrix();  // временные - в арене
+ *   }
+ *
+ * Блоки арены освобождаются, когда закрыта область и уничтожены все
+ * матрицы из неё, поэтому матрица, вынесенная за пределы области, остаётся
+ * корректной (но удерживает блоки арены до своего уничтожения).
+ * Арены вкладываются друг в друга и должны уничтожаться в обратном порядке
+ * создания - обычные локальные переменные это гарантируют. Арена действует
+ * только в создавшем её потоке: задачи пула потоков берут память из своих
+ * пулов.
+ */
+class S21MatrixArena final {
+ private:
+  s21::ArenaState* state_;
+  s21::ArenaState* previous_;
+
+ public:
+  explicit S21MatrixArena(std::size_t block_bytes = kDefaultBlockBytes);
+  S21MatrixArena(const S21MatrixArena&) = delete;
+  S21MatrixArena& operator=(const S21MatrixArena&) = delete;
+  ~S21MatrixArena();
+
+  // Сколько байт арена уже выдала (с заголовками и выравниванием)
+  std::size_t GetUsedBytes() const noexcept;
+
+  static constexpr std::size_t kDefaultBlockBytes = 1 << 20;
+};
+
+#endif  //__S21ALLOCATOR_H__
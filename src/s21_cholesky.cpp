@@ -0,0 +1,265 @@
+#include "s21_cholesky.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "s21_gemm.h"
+#include "s21_solve.h"
+#include "s21_thread_pool.h"
+
+namespace {
+// Столбцов в блоке: диагональный блок раскладывается поэлементно, остальное
+// - подстановка по строкам и Gemm
+constexpr int kCholeskyBlock = 128;
+// Строк в одной задаче пула при вычислении L21
+constexpr int kCholeskyChunk = 256;
+
+/**
+ * @brief Поэлементное разложение диагонального блока [first, last).
+ * @details Предыдущие блоки уже вычтены из него, поэтому скалярные
+ * произведения идут только по столбцам блока. false, если диагональный
+ * элемент не положителен или не конечен.
+ */
+template <typename T>
+bool FactorDiagonalBlock(T* data, int size, int first, int last) {
+  const std::size_t stride = size;
+  for (int j = first; j < last; ++j) {
+    T* row_j = data + j * stride;
+    T diagonal = row_j[j];
+    for (int k = first; k < j; ++k) {
+      diagonal -= row_j[k] * row_j[k];
+    }
+    if (!(diagonal > T(0)) || !std::isfinite(diagonal)) {
+      return false;
+    }
+    row_j[j] = std::sqrt(diagonal);
+    for (int i = j + 1; i < last; ++i) {
+      T* row_i = data + i * stride;
+      T sum = row_i[j];
+      for (int k = first; k < j; ++k) {
+        sum -= row_i[k] * row_j[k];
+      }
+      row_i[j] = sum / row_j[j];
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief L21 = A21 * L11^-T для строк ниже блока [first, last).
+ * @details Строки независимы и делятся между потоками пула, каждая -
+ * прямая подстановка с L11 по непрерывным строкам памяти.
+ */
+template <typename T>
+void SolveBlockColumn(T* data, int size, int first, int last) {
+  const std::size_t stride = size;
+  const int rows = size - last;
+  s21::ThreadPool::Global().ParallelFor(
+      (rows + kCholeskyChunk - 1) / kCholeskyChunk, [&](int chunk) {
+        const int end = std::min(size, last + (chunk + 1) * kCholeskyChunk);
+        for (int i = last + chunk * kCholeskyChunk; i < end; ++i) {
+          T* row_i = data + i * stride;
+          for (int j = first; j < last; ++j) {
+            const T* row_j = data + j * stride;
+            T sum = row_i[j];
+            for (int k = first; k < j; ++k) {
+              sum -= row_i[k] * row_j[k];
+            }
+            row_i[j] = sum / row_j[j];
+          }
+        }
+      });
+}
+
+/**
+ * @brief A22 -= L21 * L21^T по нижнему треугольнику.
+ * @details Полоса строк [i0, i1) обновляется одним вызовом s21::Gemm до
+ * столбца i1: правее диагонали блоков ничего не считается, и работа
+ * вдвое меньше, чем у полного произведения. L21^T - та же память с
+ * шагами 1 и size.
+ */
+template <typename T>
+void UpdateTrailing(T* data, int size, int first, int last) {
+  const std::size_t stride = size;
+  const int rows = size - last;
+  s21::ThreadPool::Global().ParallelFor(
+      (rows + kCholeskyBlock - 1) / kCholeskyBlock, [&](int band) {
+        const int i0 = last + band * kCholeskyBlock;
+        const int i1 = std::min(size, i0 + kCholeskyBlock);
+        s21::Gemm(i1 - i0, i1 - last, last - first, T(-1),
+                  data + i0 * stride + first, size, 1,
+                  data + last * stride + first, 1, size, T(1),
+                  data + i0 * stride + last, size);
+      });
+}
+}  // namespace
+
+/**
+ * @brief Разложение матрицы.
+ * @details
+ * Блочный правосторонний алгоритм (как dpotrf в LAPACK): для каждого
+ * блока из kCholeskyBlock столбцов
+ *   1. диагональный блок раскладывается поэлементно;
+ *   2. L21 под ним - подстановка с L11 по строкам в пуле потоков;
+ *   3. нижний треугольник остатка обновляется A22 -= L21 * L21^T через
+ *      s21::Gemm полосами строк в пуле потоков.
+ * Почти все операции приходятся на шаг 3. Разложение останавливается на
+ * первом неположительном диагональном элементе: матрица не положительно
+ * определена, и дальше считать нечего.
+ * @param matrix квадратная матрица, используется нижний треугольник
+ */
+template <typename T>
+S21CholeskyT<T>::S21CholeskyT(const S21MatrixT<T>& matrix)
+    : l_(matrix), positive_definite_(true), norm_(0) {
+  const int size = matrix.GetRows();
+  if (size < 1 || matrix.GetCols() < 1 || matrix.Data() == nullptr) {
+    throw std::out_of_range("Invalid matrix");
+  }
+  if (size != matrix.GetCols()) {
+    throw std::invalid_argument("Matrix should have square format.");
+  }
+  T* data = l_.Data();
+  // 1-норма симметричной A для ReciprocalCondition
+  std::vector<T> column_sums(size, T(0));
+  for (int i = 0; i < size; ++i) {
+    const T* row = data + static_cast<std::size_t>(i) * size;
+    column_sums[i] += std::abs(row[i]);
+    for (int j = 0; j < i; ++j) {
+      column_sums[i] += std::abs(row[j]);
+      column_sums[j] += std::abs(row[j]);
+    }
+  }
+  norm_ = *std::max_element(column_sums.begin(), column_sums.end());
+  for (int first = 0; first < size && positive_definite_;
+       first += kCholeskyBlock) {
+    const int last = std::min(size, first + kCholeskyBlock);
+    positive_definite_ = FactorDiagonalBlock(data, size, first, last);
+    if (positive_definite_ && last < size) {
+      SolveBlockColumn(data, size, first, last);
+      UpdateTrailing(data, size, first, last);
+    }
+  }
+  for (int i = 0; i < size; ++i) {
+    T* row = data + static_cast<std::size_t>(i) * size;
+    std::fill(row + i + 1, row + size, T(0));
+  }
+}
+
+template <typename T>
+int S21CholeskyT<T>::GetSize() const noexcept {
+  return l_.GetRows();
+}
+
+template <typename T>
+bool S21CholeskyT<T>::IsPositiveDefinite() const noexcept {
+  return positive_definite_;
+}
+
+template <typename T>
+const S21MatrixT<T>& S21CholeskyT<T>::GetFactor() const {
+  CheckPositiveDefinite();
+  return l_;
+}
+
+/**
+ * @brief Определитель как квадрат произведения диагонали L.
+ * @details Множители копятся мантиссой и двоичным порядком, как в
+ * S21LU::Determinant, поэтому промежуточное произведение не переполняется.
+ */
+template <typename T>
+T S21CholeskyT<T>::Determinant() const {
+  CheckPositiveDefinite();
+  T mantissa = T(1);
+  int exponent = 0;
+  for (int i = 0; i < GetSize(); ++i) {
+    int power = 0;
+    mantissa *= std::frexp(l_(i, i), &power);
+    exponent += power;
+    mantissa = std::frexp(mantissa, &power);
+    exponent += power;
+  }
+  return std::ldexp(mantissa * mantissa, 2 * exponent);
+}
+
+template <typename T>
+T S21CholeskyT<T>::LogAbsDeterminant() const {
+  CheckPositiveDefinite();
+  T res = T(0);
+  for (int i = 0; i < GetSize(); ++i) {
+    res += std::log(l_(i, i));
+  }
+  return 2 * res;
+}
+
+// A симметрична, поэтому обе подстановки оценщика одинаковы
+template <typename T>
+T S21CholeskyT<T>::ReciprocalCondition() const {
+  CheckPositiveDefinite();
+  auto solve = [this](T* x) { Substitute(x, 1); };
+  const T inverse_norm =
+      s21::EstimateInverseNorm<T>(GetSize(), solve, solve);
+  return T(1) / (norm_ * inverse_norm);
+}
+
+template <typename T>
+S21MatrixT<T> S21CholeskyT<T>::Solve(const S21MatrixT<T>& b) const {
+  S21MatrixT<T> x(b);
+  SolveInPlace(x);
+  return x;
+}
+
+template <typename T>
+std::vector<T> S21CholeskyT<T>::Solve(const std::vector<T>& b) const {
+  if (static_cast<int>(b.size()) != GetSize()) {
+    throw std::invalid_argument(
+        "Incorrect input, right-hand side should have the same rows count");
+  }
+  std::vector<T> x(b);
+  Substitute(x.data(), 1);
+  return x;
+}
+
+template <typename T>
+void S21CholeskyT<T>::SolveInPlace(S21MatrixT<T>& b) const {
+  if (b.GetRows() != GetSize() || b.GetCols() < 1) {
+    throw std::invalid_argument(
+        "Incorrect input, right-hand side should have the same rows count");
+  }
+  Substitute(b.Data(), b.GetCols());
+}
+
+template <typename T>
+S21MatrixT<T> S21CholeskyT<T>::InverseMatrix() const {
+  const int size = GetSize();
+  S21MatrixT<T> x(size, size);
+  for (int i = 0; i < size; ++i) {
+    x(i, i) = T(1);
+  }
+  SolveInPlace(x);
+  return x;
+}
+
+template <typename T>
+void S21CholeskyT<T>::CheckPositiveDefinite() const {
+  if (!positive_definite_) {
+    throw std::invalid_argument("Matrix is not positive definite.");
+  }
+}
+
+/**
+ * @brief L * Y = B, затем L^T * X = Y на месте.
+ * @details L^T - та же память с шагами 1 и n, обе подстановки - блочные
+ * s21::TriangularSolve.
+ */
+template <typename T>
+void S21CholeskyT<T>::Substitute(T* x, int cols) const {
+  CheckPositiveDefinite();
+  const int size = GetSize();
+  s21::TriangularSolve(true, false, size, cols, l_.Data(), size, 1, x, cols);
+  s21::TriangularSolve(false, false, size, cols, l_.Data(), 1, size, x, cols);
+}
+
+template class S21CholeskyT<float>;
+template class S21CholeskyT<double>;
+template class S21CholeskyT<long double>;
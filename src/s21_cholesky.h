@@ -0,0 +1,72 @@
+#ifndef __S21CHOLESKY_H__
+#define __S21CHOLESKY_H__
+
+#include <type_traits>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+/**
+ * @brief Разложение Холецкого A = L * L^T симметричной положительно
+ * определённой матрицы.
+ * @details
+ * Вдвое дешевле LU (n^3 / 3 операций) и не требует выбора главного
+ * элемента. Читается только нижний треугольник A, верхний считается
+ * симметричным ему. Разложение блочное (как dpotrf в LAPACK), обновления
+ * идут через s21::Gemm в пуле потоков. L хранится в нижнем треугольнике
+ * матрицы, выше диагонали нули.
+ *
+ * Построение бросает исключение только при неверной форме матрицы. Если
+ * A не положительно определена (очередной диагональный элемент не
+ * положителен или не конечен, как info > 0 в dpotrf), IsPositiveDefinite()
+ * возвращает false: по этому признаку можно перейти на S21LU без второго
+ * разбора исключения, остальные методы у такого объекта бросают
+ * std::invalid_argument. Плохую обусловленность показывает
+ * ReciprocalCondition.
+ * Определено для float, double и long double (S21Cholesky - для double).
+ */
+template <typename T>
+class S21CholeskyT final {
+  static_assert(std::is_floating_point<T>::value,
+                "Cholesky decomposition needs a floating point element type");
+
+ private:
+  S21MatrixT<T> l_;
+  bool positive_definite_;
+  // 1-норма исходной матрицы
+  T norm_;
+
+  void CheckPositiveDefinite() const;
+  void Substitute(T* x, int cols) const;
+
+ public:
+  explicit S21CholeskyT(const S21MatrixT<T>& matrix);
+
+  int GetSize() const noexcept;
+  bool IsPositiveDefinite() const noexcept;
+  // Множитель L
+  const S21MatrixT<T>& GetFactor() const;
+  T Determinant() const;
+  // ln det A, знак определителя положительно определённой матрицы всегда 1
+  T LogAbsDeterminant() const;
+  // Оценка обратного числа обусловленности в 1-норме, как в S21LU
+  T ReciprocalCondition() const;
+  S21MatrixT<T> Solve(const S21MatrixT<T>& b) const;
+  std::vector<T> Solve(const std::vector<T>& b) const;
+  void SolveInPlace(S21MatrixT<T>& b) const;
+  S21MatrixT<T> InverseMatrix() const;
+};
+
+using S21Cholesky = S21CholeskyT<double>;
+
+template <typename T>
+template <typename U, typename>
+S21CholeskyT<T> S21MatrixT<T>::Cholesky() const {
+  return S21CholeskyT<T>(*this);
+}
+
+extern template class S21CholeskyT<float>;
+extern template class S21CholeskyT<double>;
+extern template class S21CholeskyT<long double>;
+
+#endif  //__S21CHOLESKY_H__
@@ -0,0 +1,418 @@
+#ifndef __S21FIXEDMATRIX_H__
+#define __S21FIXEDMATRIX_H__
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+#include "s21_matrix_oop.h"
+
+/**
+ * @brief Матрица с размерами, известными при компиляции.
+ * @details
+ * Элементы лежат внутри объекта (на стеке или в объемлющей структуре),
+ * построчно, без аллокаций и проверок размеров во время выполнения:
+ * сложение матриц разных размеров или произведение с несогласованной
+ * внутренней размерностью просто не компилируется. Циклы имеют
+ * постоянные границы и разворачиваются компилятором полностью, а для
+ * 2x2, 3x3 и 4x4 определитель и обратная матрица считаются по явным
+ * формулам. Предназначена для малых матриц (преобразования 3x3, 4x4),
+ * для больших следует использовать S21Matrix.
+ *
+ * Обращение по индексу не проверяет границы, как и у S21Matrix.
+ * @tparam R число строк
+ * @tparam C число столбцов
+ * @tparam T тип элемента (float, double, long double)
+ */
+template <int R, int C, typename T = double>
+class S21FixedMatrix final {
+  static_assert(R > 0 && C > 0, "Matrix size must be greater than 0");
+  static_assert(std::is_floating_point<T>::value,
+                "Element type must be a floating point type");
+
+ private:
+  T data_[R * C];
+
+ public:
+  static constexpr int kRows = R;
+  static constexpr int kCols = C;
+
+  constexpr S21FixedMatrix() noexcept : data_() {}
+
+  // Создание из S21MatrixT: размеры проверяются во время выполнения.
+  // Обычно U совпадает с T (S21MatrixF для float), иначе элементы
+  // приводятся к T.
+  template <typename U>
+  explicit S21FixedMatrix(const S21MatrixT<U>& other) : data_() {
+    if (other.GetRows() != R || other.GetCols() != C) {
+      throw std::out_of_range(
+          "Incorrect input, matricex should have the same size");
+    }
+    for (int i = 0; i < R; ++i) {
+      for (int j = 0; j < C; ++j) {
+        (*this)(i, j) = static_cast<T>(other(i, j));
+      }
+    }
+  }
+
+  // Копия в S21MatrixT с любым типом элементов, без потерь - в S21MatrixT<T>
+  template <typename U>
+  explicit operator S21MatrixT<U>() const {
+    S21MatrixT<U> res(R, C);
+    for (int i = 0; i < R; ++i) {
+      for (int j = 0; j < C; ++j) {
+        res(i, j) = static_cast<U>((*this)(i, j));
+      }
+    }
+    return res;
+  }
+
+  static constexpr S21FixedMatrix Identity() noexcept {
+    static_assert(R == C, "Matrix should have square format.");
+    S21FixedMatrix res;
+    for (int i = 0; i < R; ++i) {
+      res(i, i) = T(1);
+    }
+    return res;
+  }
+
+  constexpr int GetRows() const noexcept { return R; }
+  constexpr int GetCols() const noexcept { return C; }
+  constexpr T* Data() noexcept { return data_; }
+  constexpr const T* Data() const noexcept { return data_; }
+
+  constexpr T& operator()(int row, int col) noexcept {
+    return data_[row * C + col];
+  }
+  constexpr T operator()(int row, int col) const noexcept {
+    return data_[row * C + col];
+  }
+
+  // Допуск s21::ScalarTraits<T>::kEpsilon, как у S21MatrixT<T>::EqMatrix
+  constexpr bool EqMatrix(const S21FixedMatrix& other) const noexcept {
+    constexpr T eps = s21::ScalarTraits<T>::kEpsilon;
+    bool is_eq = true;
+#pragma GCC unroll 16
+    for (int i = 0; i < R * C; ++i) {
+      T diff = data_[i] - other.data_[i];
+      if (diff > eps || diff < -eps) {
+        is_eq = false;
+      }
+    }
+    return is_eq;
+  }
+
+  constexpr S21FixedMatrix& operator+=(
+      const S21FixedMatrix& other) noexcept {
+#pragma GCC unroll 16
+    for (int i = 0; i < R * C; ++i) {
+      data_[i] += other.data_[i];
+    }
+    return *this;
+  }
+
+  constexpr S21FixedMatrix& operator-=(
+      const S21FixedMatrix& other) noexcept {
+#pragma GCC unroll 16
+    for (int i = 0; i < R * C; ++i) {
+      data_[i] -= other.data_[i];
+    }
+    return *this;
+  }
+
+  constexpr S21FixedMatrix& operator*=(T num) noexcept {
+#pragma GCC unroll 16
+    for (int i = 0; i < R * C; ++i) {
+      data_[i] *= num;
+    }
+    return *this;
+  }
+
+  // Умножение на месте возможно только на квадратную [C x C]
+  constexpr S21FixedMatrix& operator*=(
+      const S21FixedMatrix<C, C, T>& other) noexcept {
+    *this = *this * other;
+    return *this;
+  }
+
+  constexpr S21FixedMatrix<C, R, T> Transpose() const noexcept {
+    S21FixedMatrix<C, R, T> res;
+    for (int i = 0; i < R; ++i) {
+      for (int j = 0; j < C; ++j) {
+        res(j, i) = (*this)(i, j);
+      }
+    }
+    return res;
+  }
+
+  constexpr T Determinant() const noexcept;
+  S21FixedMatrix InverseMatrix() const;
+};
+
+template <int R, int C, typename T>
+constexpr S21FixedMatrix<R, C, T> operator+(
+    S21FixedMatrix<R, C, T> lhs, const S21FixedMatrix<R, C, T>& rhs) noexcept {
+  return lhs += rhs;
+}
+
+template <int R, int C, typename T>
+constexpr S21FixedMatrix<R, C, T> operator-(
+    S21FixedMatrix<R, C, T> lhs, const S21FixedMatrix<R, C, T>& rhs) noexcept {
+  return lhs -= rhs;
+}
+
+// Тип числа не выводится, поэтому A * 2 тоже компилируется
+template <int R, int C, typename T>
+constexpr S21FixedMatrix<R, C, T> operator*(S21FixedMatrix<R, C, T> lhs,
+                                            std::common_type_t<T> num) {
+  return lhs *= num;
+}
+
+template <int R, int C, typename T>
+constexpr S21FixedMatrix<R, C, T> operator*(std::common_type_t<T> num,
+                                            S21FixedMatrix<R, C, T> rhs) {
+  return rhs *= num;
+}
+
+/**
+ * @brief Произведение [R x K] * [K x C].
+ * @details Несогласованные размеры отсекаются при выводе шаблона.
+ * Порядок i-k-j, все три цикла разворачиваются.
+ */
+template <int R, int K, int C, typename T>
+constexpr S21FixedMatrix<R, C, T> operator*(
+    const S21FixedMatrix<R, K, T>& lhs,
+    const S21FixedMatrix<K, C, T>& rhs) noexcept {
+  S21FixedMatrix<R, C, T> res;
+#pragma GCC unroll 16
+  for (int i = 0; i < R; ++i) {
+#pragma GCC unroll 16
+    for (int k = 0; k < K; ++k) {
+      const T a_ik = lhs(i, k);
+#pragma GCC unroll 16
+      for (int j = 0; j < C; ++j) {
+        res(i, j) += a_ik * rhs(k, j);
+      }
+    }
+  }
+  return res;
+}
+
+template <int R, int C, typename T>
+constexpr bool operator==(const S21FixedMatrix<R, C, T>& lhs,
+                          const S21FixedMatrix<R, C, T>& rhs) noexcept {
+  return lhs.EqMatrix(rhs);
+}
+
+namespace s21 {
+namespace fixed {
+// std::abs и std::swap становятся constexpr только в C++20
+template <typename T>
+constexpr T Abs(T value) noexcept {
+  return value < T(0) ? -value : value;
+}
+
+template <typename T>
+constexpr void Swap(T& a, T& b) noexcept {
+  T tmp = a;
+  a = b;
+  b = tmp;
+}
+
+/**
+ * @brief Определитель квадратной матрицы общего вида.
+ * @details Метод Гаусса с выбором главного элемента по столбцу на копии
+ * матрицы. Используется для порядков больше 4.
+ */
+template <int N, typename T>
+constexpr T GaussDeterminant(S21FixedMatrix<N, N, T> m) noexcept {
+  T det = T(1);
+  for (int i = 0; i < N; ++i) {
+    int pivot = i;
+    for (int r = i + 1; r < N; ++r) {
+      if (Abs(m(r, i)) > Abs(m(pivot, i))) {
+        pivot = r;
+      }
+    }
+    if (m(pivot, i) == T(0)) {
+      return T(0);
+    }
+    if (pivot != i) {
+      for (int c = i; c < N; ++c) {
+        Swap(m(i, c), m(pivot, c));
+      }
+      det = -det;
+    }
+    det *= m(i, i);
+    for (int r = i + 1; r < N; ++r) {
+      const T coeff = m(r, i) / m(i, i);
+      for (int c = i + 1; c < N; ++c) {
+        m(r, c) -= coeff * m(i, c);
+      }
+    }
+  }
+  return det;
+}
+
+/**
+ * @brief Обратная матрица общего вида методом Гаусса-Жордана.
+ * @details Возвращает false для вырожденной матрицы.
+ */
+template <int N, typename T>
+bool GaussJordanInverse(S21FixedMatrix<N, N, T> m,
+                        S21FixedMatrix<N, N, T>& res) noexcept {
+  res = S21FixedMatrix<N, N, T>::Identity();
+  for (int i = 0; i < N; ++i) {
+    int pivot = i;
+    for (int r = i + 1; r < N; ++r) {
+      if (Abs(m(r, i)) > Abs(m(pivot, i))) {
+        pivot = r;
+      }
+    }
+    if (m(pivot, i) == T(0)) {
+      return false;
+    }
+    if (pivot != i) {
+      for (int c = 0; c < N; ++c) {
+        Swap(m(i, c), m(pivot, c));
+        Swap(res(i, c), res(pivot, c));
+      }
+    }
+    const T inv_pivot = T(1) / m(i, i);
+    for (int c = 0; c < N; ++c) {
+      m(i, c) *= inv_pivot;
+      res(i, c) *= inv_pivot;
+    }
+    for (int r = 0; r < N; ++r) {
+      if (r != i) {
+        const T coeff = m(r, i);
+        for (int c = 0; c < N; ++c) {
+          m(r, c) -= coeff * m(i, c);
+          res(r, c) -= coeff * res(i, c);
+        }
+      }
+    }
+  }
+  return true;
+}
+}  // namespace fixed
+}  // namespace s21
+
+/**
+ * @brief Определитель.
+ * @details До 3x3 - явные формулы, 4x4 - разложение по парам строк через
+ * шесть миноров 2x2 верхней и нижней половины (те же миноры затем
+ * используются в InverseMatrix), для больших порядков - метод Гаусса.
+ */
+template <int R, int C, typename T>
+constexpr T S21FixedMatrix<R, C, T>::Determinant() const noexcept {
+  static_assert(R == C, "Matrix should have square format.");
+  const S21FixedMatrix& a = *this;
+  if constexpr (R == 1) {
+    return a(0, 0);
+  } else if constexpr (R == 2) {
+    return a(0, 0) * a(1, 1) - a(0, 1) * a(1, 0);
+  } else if constexpr (R == 3) {
+    return a(0, 0) * (a(1, 1) * a(2, 2) - a(1, 2) * a(2, 1)) -
+           a(0, 1) * (a(1, 0) * a(2, 2) - a(1, 2) * a(2, 0)) +
+           a(0, 2) * (a(1, 0) * a(2, 1) - a(1, 1) * a(2, 0));
+  } else if constexpr (R == 4) {
+    const T s0 = a(0, 0) * a(1, 1) - a(1, 0) * a(0, 1);
+    const T s1 = a(0, 0) * a(1, 2) - a(1, 0) * a(0, 2);
+    const T s2 = a(0, 0) * a(1, 3) - a(1, 0) * a(0, 3);
+    const T s3 = a(0, 1) * a(1, 2) - a(1, 1) * a(0, 2);
+    const T s4 = a(0, 1) * a(1, 3) - a(1, 1) * a(0, 3);
+    const T s5 = a(0, 2) * a(1, 3) - a(1, 2) * a(0, 3);
+    const T c5 = a(2, 2) * a(3, 3) - a(3, 2) * a(2, 3);
+    const T c4 = a(2, 1) * a(3, 3) - a(3, 1) * a(2, 3);
+    const T c3 = a(2, 1) * a(3, 2) - a(3, 1) * a(2, 2);
+    const T c2 = a(2, 0) * a(3, 3) - a(3, 0) * a(2, 3);
+    const T c1 = a(2, 0) * a(3, 2) - a(3, 0) * a(2, 2);
+    const T c0 = a(2, 0) * a(3, 1) - a(3, 0) * a(2, 1);
+    return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+  } else {
+    return s21::fixed::GaussDeterminant(a);
+  }
+}
+
+/**
+ * @brief Обратная матрица.
+ * @details Для 2x2 - 4x4 - присоединённая матрица по явным формулам,
+ * делённая на определитель, для больших порядков - метод Гаусса-Жордана.
+ * Как и S21Matrix::InverseMatrix, для вырожденной матрицы выбрасывает
+ * std::invalid_argument.
+ */
+template <int R, int C, typename T>
+S21FixedMatrix<R, C, T> S21FixedMatrix<R, C, T>::InverseMatrix() const {
+  static_assert(R == C, "Matrix should have square format.");
+  const S21FixedMatrix& a = *this;
+  S21FixedMatrix res;
+  bool singular = false;
+  if constexpr (R <= 4) {
+    const T det = Determinant();
+    singular = det == T(0);
+    if (!singular) {
+      const T inv = T(1) / det;
+      if constexpr (R == 1) {
+        res(0, 0) = inv;
+      } else if constexpr (R == 2) {
+        res(0, 0) = a(1, 1) * inv;
+        res(0, 1) = -a(0, 1) * inv;
+        res(1, 0) = -a(1, 0) * inv;
+        res(1, 1) = a(0, 0) * inv;
+      } else if constexpr (R == 3) {
+        res(0, 0) = (a(1, 1) * a(2, 2) - a(1, 2) * a(2, 1)) * inv;
+        res(0, 1) = (a(0, 2) * a(2, 1) - a(0, 1) * a(2, 2)) * inv;
+        res(0, 2) = (a(0, 1) * a(1, 2) - a(0, 2) * a(1, 1)) * inv;
+        res(1, 0) = (a(1, 2) * a(2, 0) - a(1, 0) * a(2, 2)) * inv;
+        res(1, 1) = (a(0, 0) * a(2, 2) - a(0, 2) * a(2, 0)) * inv;
+        res(1, 2) = (a(0, 2) * a(1, 0) - a(0, 0) * a(1, 2)) * inv;
+        res(2, 0) = (a(1, 0) * a(2, 1) - a(1, 1) * a(2, 0)) * inv;
+        res(2, 1) = (a(0, 1) * a(2, 0) - a(0, 0) * a(2, 1)) * inv;
+        res(2, 2) = (a(0, 0) * a(1, 1) - a(0, 1) * a(1, 0)) * inv;
+      } else {
+        const T s0 = a(0, 0) * a(1, 1) - a(1, 0) * a(0, 1);
+        const T s1 = a(0, 0) * a(1, 2) - a(1, 0) * a(0, 2);
+        const T s2 = a(0, 0) * a(1, 3) - a(1, 0) * a(0, 3);
+        const T s3 = a(0, 1) * a(1, 2) - a(1, 1) * a(0, 2);
+        const T s4 = a(0, 1) * a(1, 3) - a(1, 1) * a(0, 3);
+        const T s5 = a(0, 2) * a(1, 3) - a(1, 2) * a(0, 3);
+        const T c5 = a(2, 2) * a(3, 3) - a(3, 2) * a(2, 3);
+        const T c4 = a(2, 1) * a(3, 3) - a(3, 1) * a(2, 3);
+        const T c3 = a(2, 1) * a(3, 2) - a(3, 1) * a(2, 2);
+        const T c2 = a(2, 0) * a(3, 3) - a(3, 0) * a(2, 3);
+        const T c1 = a(2, 0) * a(3, 2) - a(3, 0) * a(2, 2);
+        const T c0 = a(2, 0) * a(3, 1) - a(3, 0) * a(2, 1);
+        res(0, 0) = (a(1, 1) * c5 - a(1, 2) * c4 + a(1, 3) * c3) * inv;
+        res(0, 1) = (-a(0, 1) * c5 + a(0, 2) * c4 - a(0, 3) * c3) * inv;
+        res(0, 2) = (a(3, 1) * s5 - a(3, 2) * s4 + a(3, 3) * s3) * inv;
+        res(0, 3) = (-a(2, 1) * s5 + a(2, 2) * s4 - a(2, 3) * s3) * inv;
+        res(1, 0) = (-a(1, 0) * c5 + a(1, 2) * c2 - a(1, 3) * c1) * inv;
+        res(1, 1) = (a(0, 0) * c5 - a(0, 2) * c2 + a(0, 3) * c1) * inv;
+        res(1, 2) = (-a(3, 0) * s5 + a(3, 2) * s2 - a(3, 3) * s1) * inv;
+        res(1, 3) = (a(2, 0) * s5 - a(2, 2) * s2 + a(2, 3) * s1) * inv;
+        res(2, 0) = (a(1, 0) * c4 - a(1, 1) * c2 + a(1, 3) * c0) * inv;
+        res(2, 1) = (-a(0, 0) * c4 + a(0, 1) * c2 - a(0, 3) * c0) * inv;
+        res(2, 2) = (a(3, 0) * s4 - a(3, 1) * s2 + a(3, 3) * s0) * inv;
+        res(2, 3) = (-a(2, 0) * s4 + a(2, 1) * s2 - a(2, 3) * s0) * inv;
+        res(3, 0) = (-a(1, 0) * c3 + a(1, 1) * c1 - a(1, 2) * c0) * inv;
+        res(3, 1) = (a(0, 0) * c3 - a(0, 1) * c1 + a(0, 2) * c0) * inv;
+        res(3, 2) = (-a(3, 0) * s3 + a(3, 1) * s1 - a(3, 2) * s0) * inv;
+        res(3, 3) = (a(2, 0) * s3 - a(2, 1) * s1 + a(2, 2) * s0) * inv;
+      }
+    }
+  } else {
+    singular = !s21::fixed::GaussJordanInverse(a, res);
+  }
+  if (singular) {
+    throw std::invalid_argument("Determinant for this matrix is equal 0.");
+  }
+  return res;
+}
+
+using S21Matrix3d = S21FixedMatrix<3, 3>;
+using S21Matrix4d = S21FixedMatrix<4, 4>;
+using S21Matrix3f = S21FixedMatrix<3, 3, float>;
+using S21Matrix4f = S21FixedMatrix<4, 4, float>;
+
+#endif  //__S21FIXEDMATRIX_H__
@@ -0,0 +1,238 @@
+#include "s21_gemm.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "s21_thread_pool.h"
+
+namespace {
+// Размеры микроядра: блок C kMr x kNr целиком живёт в регистрах
+constexpr int kMr = 4;
+constexpr int kNr = 8;
+// Размеры панелей: A kMc x kKc помещается в L2, полоса B kKc x kNr - в L1
+constexpr int kMc = 96;
+constexpr int kKc = 256;
+constexpr int kNc = 2048;
+// Ширина плитки C (kMc строк), которую в параллельном режиме получает
+// одна задача пула; кратна kNr, чтобы полосы B не делились между задачами
+constexpr int kTileCols = 512;
+static_assert(kTileCols % kNr == 0, "Tile must hold whole B strips");
+
+/**
+ * @brief Упаковка блока A [mc x kc] полосами по kMr строк.
+ * @details Внутри полосы элементы лежат по столбцам: pa[p * kMr + i].
+ * Неполная последняя полоса дополняется нулями.
+ */
+template <typename T>
+void PackA(int mc, int kc, const T* a, int rs, int cs, T* pa) {
+  for (int ir = 0; ir < mc; ir += kMr) {
+    int mr = std::min(kMr, mc - ir);
+    for (int p = 0; p < kc; ++p) {
+      for (int i = 0; i < kMr; ++i) {
+        pa[p * kMr + i] = i < mr ? a[(ir + i) * rs + p * cs] : T(0);
+      }
+    }
+    pa += kc * kMr;
+  }
+}
+
+/**
+ * @brief Упаковка блока B [kc x nc] полосами по kNr столбцов.
+ * @details Внутри полосы элементы лежат по строкам: pb[p * kNr + j].
+ */
+template <typename T>
+void PackB(int kc, int nc, const T* b, int rs, int cs, T* pb) {
+  for (int jr = 0; jr < nc; jr += kNr) {
+    int nr = std::min(kNr, nc - jr);
+    for (int p = 0; p < kc; ++p) {
+      for (int j = 0; j < kNr; ++j) {
+        pb[p * kNr + j] = j < nr ? b[p * rs + (jr + j) * cs] : T(0);
+      }
+    }
+    pb += kc * kNr;
+  }
+}
+
+/**
+ * @brief Микроядро: C[mr x nr] += alpha * pa * pb.
+ * @details Аккумулятор фиксированного размера kMr x kNr компилятор
+ * раскладывает по векторным регистрам, в память пишется только
+ * действительная часть блока.
+ */
+template <typename T>
+void MicroKernel(int kc, T alpha, const T* __restrict pa,
+                 const T* __restrict pb, T* c, int rsc, int mr, int nr) {
+  T acc[kMr][kNr] = {};
+  for (int p = 0; p < kc; ++p) {
+    for (int i = 0; i < kMr; ++i) {
+      const T a_ip = pa[i];
+      for (int j = 0; j < kNr; ++j) {
+        acc[i][j] += a_ip * pb[j];
+      }
+    }
+    pa += kMr;
+    pb += kNr;
+  }
+  for (int i = 0; i < mr; ++i) {
+    for (int j = 0; j < nr; ++j) {
+      c[i * rsc + j] += alpha * acc[i][j];
+    }
+  }
+}
+
+template <typename T>
+void ScaleC(int m, int n, T beta, T* c, int rsc) {
+  for (int i = 0; i < m; ++i) {
+    T* row = c + i * rsc;
+    if (beta == T(0)) {
+      std::fill_n(row, n, T(0));
+    } else if (beta != T(1)) {
+      for (int j = 0; j < n; ++j) {
+        row[j] *= beta;
+      }
+    }
+  }
+}
+
+// Блок C [mc x nc] += alpha * pa * pb по упакованным панелям
+template <typename T>
+void MacroKernel(int mc, int nc, int kc, T alpha, const T* packed_a,
+                 const T* packed_b, T* c, int c_row_stride) {
+  for (int jr = 0; jr < nc; jr += kNr) {
+    const T* pb = packed_b + jr * kc;
+    for (int ir = 0; ir < mc; ir += kMr) {
+      const T* pa = packed_a + ir * kc;
+      MicroKernel(kc, alpha, pa, pb,
+                  c + static_cast<std::ptrdiff_t>(ir) * c_row_stride + jr,
+                  c_row_stride, std::min(kMr, mc - ir),
+                  std::min(kNr, nc - jr));
+    }
+  }
+}
+
+// Панель A [mc x kc] с позиции (ic, pc) в буфер потока
+template <typename T>
+const T* PackAPanel(int mc, int kc, const T* a, int a_row_stride,
+                    int a_col_stride, int ic, int pc) {
+  thread_local std::vector<T> packed_a;
+  packed_a.resize(static_cast<std::size_t>(kMc + kMr) * kKc);
+  PackA(mc, kc,
+        a + static_cast<std::ptrdiff_t>(ic) * a_row_stride +
+            static_cast<std::ptrdiff_t>(pc) * a_col_stride,
+        a_row_stride, a_col_stride, packed_a.data());
+  return packed_a.data();
+}
+
+template <typename T>
+void GemmSerial(int m, int n, int k, T alpha, const T* a, int a_row_stride,
+                int a_col_stride, const T* b, int b_row_stride,
+                int b_col_stride, T* c, int c_row_stride) {
+  // Буферы упаковки переиспользуются между вызовами в пределах потока
+  thread_local std::vector<T> packed_b;
+  packed_b.resize(static_cast<std::size_t>(kNc + kNr) * kKc);
+
+  for (int jc = 0; jc < n; jc += kNc) {
+    int nc = std::min(kNc, n - jc);
+    for (int pc = 0; pc < k; pc += kKc) {
+      int kc = std::min(kKc, k - pc);
+      PackB(kc, nc,
+            b + static_cast<std::ptrdiff_t>(pc) * b_row_stride +
+                static_cast<std::ptrdiff_t>(jc) * b_col_stride,
+            b_row_stride, b_col_stride, packed_b.data());
+      for (int ic = 0; ic < m; ic += kMc) {
+        int mc = std::min(kMc, m - ic);
+        const T* packed_a =
+            PackAPanel(mc, kc, a, a_row_stride, a_col_stride, ic, pc);
+        MacroKernel(mc, nc, kc, alpha, packed_a, packed_b.data(),
+                    c + static_cast<std::ptrdiff_t>(ic) * c_row_stride + jc,
+                    c_row_stride);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Параллельный Gemm.
+ * @details Панель B [kc x nc] упаковывается один раз на итерацию (jc, pc)
+ * в общий буфер (полосы пакуются задачами пула), затем задачи делят C
+ * на плитки kMc x kTileCols: каждая пакует свою панель A и читает общую
+ * B. Плитки C не пересекаются, а слои pc идут по очереди, так что
+ * синхронизация нужна только между ParallelFor.
+ */
+template <typename T>
+void GemmParallel(s21::ThreadPool& pool, int m, int n, int k, T alpha,
+                  const T* a, int a_row_stride, int a_col_stride, const T* b,
+                  int b_row_stride, int b_col_stride, T* c,
+                  int c_row_stride) {
+  // Буфер вызова, а не потока: пока вызывающий поток ждёт, он может
+  // выполнить задачу другого Gemm, которой тоже нужна своя панель B
+  const int max_nc = std::min(kNc, n);
+  std::vector<T> packed_b(static_cast<std::size_t>(max_nc + kNr - 1) / kNr *
+                          kNr * std::min(kKc, k));
+  const int tiles_m = (m + kMc - 1) / kMc;
+  for (int jc = 0; jc < n; jc += kNc) {
+    const int nc = std::min(kNc, n - jc);
+    const int tiles_n = (nc + kTileCols - 1) / kTileCols;
+    for (int pc = 0; pc < k; pc += kKc) {
+      const int kc = std::min(kKc, k - pc);
+      // Полосы B пакуются кусками по kTileCols столбцов
+      pool.ParallelFor(tiles_n, [&](int tile) {
+        const int j0 = tile * kTileCols;
+        PackB(kc, std::min(kTileCols, nc - j0),
+              b + static_cast<std::ptrdiff_t>(pc) * b_row_stride +
+                  static_cast<std::ptrdiff_t>(jc + j0) * b_col_stride,
+              b_row_stride, b_col_stride,
+              packed_b.data() + static_cast<std::size_t>(j0) * kc);
+      });
+      pool.ParallelFor(tiles_m * tiles_n, [&](int tile) {
+        const int ic = tile / tiles_n * kMc;
+        const int j0 = tile % tiles_n * kTileCols;
+        const int mc = std::min(kMc, m - ic);
+        const T* packed_a =
+            PackAPanel(mc, kc, a, a_row_stride, a_col_stride, ic, pc);
+        MacroKernel(mc, std::min(kTileCols, nc - j0), kc, alpha, packed_a,
+                    packed_b.data() + static_cast<std::size_t>(j0) * kc,
+                    c + static_cast<std::ptrdiff_t>(ic) * c_row_stride + jc +
+                        j0,
+                    c_row_stride);
+      });
+    }
+  }
+}
+}  // namespace
+
+namespace s21 {
+template <typename T>
+void Gemm(int m, int n, int k, T alpha, const T* a, int a_row_stride,
+          int a_col_stride, const T* b, int b_row_stride, int b_col_stride,
+          T beta, T* c, int c_row_stride) {
+  if (m <= 0 || n <= 0) {
+    return;
+  }
+  ScaleC(m, n, beta, c, c_row_stride);
+  if (k <= 0 || alpha == T(0)) {
+    return;
+  }
+  ThreadPool& pool = ThreadPool::Global();
+  if (pool.GetThreadCount() == 1 ||
+      static_cast<std::int64_t>(m) * n * k < kParallelGemmThreshold) {
+    GemmSerial(m, n, k, alpha, a, a_row_stride, a_col_stride, b, b_row_stride,
+               b_col_stride, c, c_row_stride);
+  } else {
+    GemmParallel(pool, m, n, k, alpha, a, a_row_stride, a_col_stride, b,
+                 b_row_stride, b_col_stride, c, c_row_stride);
+  }
+}
+
+#define S21_GEMM_INSTANTIATE(T)                                              \
+  template void Gemm(int m, int n, int k, T alpha, const T* a,               \
+                     int a_row_stride, int a_col_stride, const T* b,         \
+                     int b_row_stride, int b_col_stride, T beta, T* c,       \
+                     int c_row_stride);
+
+S21_GEMM_INSTANTIATE(float)
+S21_GEMM_INSTANTIATE(double)
+S21_GEMM_INSTANTIATE(long double)
+S21_GEMM_INSTANTIATE(std::int64_t)
+#undef S21_GEMM_INSTANTIATE
+}  // namespace s21
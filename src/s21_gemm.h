@@ -0,0 +1,38 @@
+#ifndef __S21GEMM_H__
+#define __S21GEMM_H__
+
+#include <cstdint>
+
+namespace s21 {
+/**
+ * @brief Порог (в умножениях m * n * k), начиная с которого MulMatrix
+ * переходит с наивного цикла на блочное умножение Gemm.
+ */
+constexpr std::int64_t kGemmThreshold = 32 * 32 * 32;
+/**
+ * @brief Порог, начиная с которого Gemm делит C на плитки и считает их
+ * в пуле потоков (см. s21::SetNumThreads). Меньшие задачи считаются
+ * последовательно.
+ */
+constexpr std::int64_t kParallelGemmThreshold = 128 * 128 * 128;
+
+/**
+ * @brief Блочное умножение матриц C = alpha * A * B + beta * C.
+ * @details
+ * Матрицы задаются указателем и шагами по строке/столбцу, поэтому на вход
+ * можно подавать и транспонированные, и вырезанные из большей матрицы блоки.
+ * A упаковывается панелями kMc x kKc, B - панелями kKc x kNc, сами
+ * вычисления идут в микроядре kMr x kNr на регистрах (схема GotoBLAS).
+ * При beta == 0 старое содержимое C не читается. Определено для float,
+ * double, long double и std::int64_t.
+ * @param m число строк A и C
+ * @param n число столбцов B и C
+ * @param k число столбцов A и строк B
+ */
+template <typename T>
+void Gemm(int m, int n, int k, T alpha, const T* a, int a_row_stride,
+          int a_col_stride, const T* b, int b_row_stride, int b_col_stride,
+          T beta, T* c, int c_row_stride);
+}  // namespace s21
+
+#endif  //__S21GEMM_H__
@@ -0,0 +1,330 @@
+#include "s21_lu.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "s21_gemm.h"
+#include "s21_solve.h"
+#include "s21_thread_pool.h"
+
+namespace {
+// Ширина панели: столбцы панели раскладываются построчно, остальное - Gemm
+constexpr int kLuBlock = 128;
+// Строк в одной задаче пула при разложении панели
+constexpr int kLuChunk = 256;
+
+/**
+ * @brief Разложение панели - столбцов [first, last) ниже строки first.
+ * @details Строки при выборе ведущего элемента меняются целиком, вместе
+ * с уже готовыми множителями L слева и ещё не обновлёнными столбцами
+ * справа, как в LAPACK. Множители пропущенного вырожденного столбца
+ * обнуляются, чтобы он не участвовал в обновлении остатка матрицы.
+ */
+template <typename T>
+void FactorPanel(T* data, int size, int first, int last, int* pivots,
+                 int& sign, bool& singular) {
+  const std::size_t stride = size;
+  for (int i = first; i < last; ++i) {
+    int pivot = i;
+    for (int j = i + 1; j < size; ++j) {
+      if (std::abs(data[j * stride + i]) >
+          std::abs(data[pivot * stride + i])) {
+        pivot = j;
+      }
+    }
+    pivots[i] = i;
+    const T largest = std::abs(data[pivot * stride + i]);
+    if (!(largest > T(0)) || !std::isfinite(largest)) {
+      singular = true;
+      for (int j = i + 1; j < size; ++j) {
+        data[j * stride + i] = T(0);
+      }
+      continue;
+    }
+    if (pivot != i) {
+      std::swap_ranges(data + i * stride, data + (i + 1) * stride,
+                       data + pivot * stride);
+      pivots[i] = pivot;
+      sign = -sign;
+    }
+    const T* pivot_row = data + i * stride;
+    const int rows = size - i - 1;
+    s21::ThreadPool::Global().ParallelFor(
+        (rows + kLuChunk - 1) / kLuChunk, [&](int chunk) {
+          const int end = std::min(size, i + 1 + (chunk + 1) * kLuChunk);
+          for (int j = i + 1 + chunk * kLuChunk; j < end; ++j) {
+            T* row = data + j * stride;
+            const T coeff = row[i] / pivot_row[i];
+            row[i] = coeff;
+            for (int k = i + 1; k < last; ++k) {
+              row[k] -= pivot_row[k] * coeff;
+            }
+          }
+        });
+  }
+}
+
+}  // namespace
+
+/**
+ * @brief Разложение матрицы.
+ * @details
+ * Блочный правосторонний алгоритм (как dgetrf в LAPACK). Для каждой
+ * панели из kLuBlock столбцов:
+ *   1. панель раскладывается по столбцам с выбором ведущего элемента;
+ *   2. строки U справа от панели - треугольное решение с L панели
+ *      (s21::TriangularSolve);
+ *   3. остаток матрицы обновляется одним произведением
+ *      A22 -= L21 * U12 через s21::Gemm.
+ * Почти все O(n^3) операций приходятся на шаг 3, который идёт упакованными
+ * блоками на регистрах и делится между потоками пула, шаги 1 и 2 тоже
+ * параллельны по строкам и столбцам. Для матриц меньше kLuBlock это
+ * обычное исключение Гаусса.
+ *
+ * Строки переставляются физически, pivots_[i] хранит номер строки, с
+ * которой на шаге i поменялась строка i (как ipiv в LAPACK). Столбец с
+ * нулевым или не конечным ведущим элементом пропускается, а матрица
+ * помечается вырожденной (как info > 0 в dgetrf). Малый, но ненулевой
+ * элемент вырожденности не означает: матрица вроде [[1e8, 1], [0, 1]]
+ * хорошо обусловлена, а потерю точности показывает ReciprocalCondition.
+ * @param matrix квадратная матрица
+ */
+template <typename T>
+S21LUT<T>::S21LUT(const S21MatrixT<T>& matrix)
+    : lu_(matrix),
+      pivots_(matrix.GetRows()),
+      sign_(1),
+      singular_(false),
+      norm_(0) {
+  int size = matrix.GetRows();
+  if (size < 1 || matrix.GetCols() < 1 || matrix.Data() == nullptr) {
+    throw std::out_of_range("Invalid matrix");
+  }
+  if (size != matrix.GetCols()) {
+    throw std::invalid_argument("Matrix should have square format.");
+  }
+  T* data = lu_.Data();
+  // 1-норма для ReciprocalCondition
+  std::vector<T> column_sums(size, T(0));
+  for (int i = 0; i < size; ++i) {
+    const T* row = data + static_cast<std::size_t>(i) * size;
+    for (int j = 0; j < size; ++j) {
+      column_sums[j] += std::abs(row[j]);
+    }
+  }
+  norm_ = *std::max_element(column_sums.begin(), column_sums.end());
+  for (int first = 0; first < size; first += kLuBlock) {
+    const int last = std::min(size, first + kLuBlock);
+    FactorPanel(data, size, first, last, pivots_.data(), sign_, singular_);
+    if (last < size) {
+      // Строки U справа от панели: U12 = L11^-1 * A12
+      s21::TriangularSolve(true, true, last - first, size - last,
+                           data + static_cast<std::size_t>(first) * size +
+                               first,
+                           size, 1,
+                           data + static_cast<std::size_t>(first) * size +
+                               last,
+                           size);
+      const std::size_t offset = static_cast<std::size_t>(last) * size;
+      s21::Gemm(size - last, size - last, last - first, T(-1),
+                data + offset + first, size, 1,
+                data + static_cast<std::size_t>(first) * size + last, size, 1,
+                T(1), data + offset + last, size);
+    }
+  }
+}
+
+template <typename T>
+int S21LUT<T>::GetSize() const noexcept {
+  return lu_.GetRows();
+}
+
+template <typename T>
+bool S21LUT<T>::IsSingular() const noexcept {
+  return singular_;
+}
+
+/**
+ * @brief Определитель как произведение диагонали U.
+ * @details Множители копятся мантиссой и двоичным порядком (frexp), так
+ * что промежуточное произведение не переполняется и не уходит в ноль:
+ * inf или 0 получаются, только если сам определитель не представим в T.
+ */
+template <typename T>
+T S21LUT<T>::Determinant() const noexcept {
+  T res = T(0);
+  if (!singular_) {
+    T mantissa = sign_;
+    int exponent = 0;
+    for (int i = 0; i < GetSize(); ++i) {
+      int power = 0;
+      mantissa *= std::frexp(lu_(i, i), &power);
+      exponent += power;
+      mantissa = std::frexp(mantissa, &power);
+      exponent += power;
+    }
+    res = std::ldexp(mantissa, exponent);
+  }
+  return res;
+}
+
+template <typename T>
+T S21LUT<T>::LogAbsDeterminant() const noexcept {
+  T res = -std::numeric_limits<T>::infinity();
+  if (!singular_) {
+    res = T(0);
+    for (int i = 0; i < GetSize(); ++i) {
+      res += std::log(std::abs(lu_(i, i)));
+    }
+  }
+  return res;
+}
+
+template <typename T>
+int S21LUT<T>::GetSign() const noexcept {
+  int res = 0;
+  if (!singular_) {
+    res = sign_;
+    for (int i = 0; i < GetSize(); ++i) {
+      if (lu_(i, i) < T(0)) {
+        res = -res;
+      }
+    }
+  }
+  return res;
+}
+
+// 1 / (||A||_1 * ||A^-1||_1), ||A^-1||_1 - оценка s21::EstimateInverseNorm
+template <typename T>
+T S21LUT<T>::ReciprocalCondition() const {
+  if (singular_ || !(norm_ > T(0))) {
+    return T(0);
+  }
+  const T inverse_norm = s21::EstimateInverseNorm<T>(
+      GetSize(),
+      [this](T* x) {
+        Permute(x, 1);
+        Substitute(x, 1);
+      },
+      [this](T* x) { SubstituteTransposed(x); });
+  return T(1) / (norm_ * inverse_norm);
+}
+
+/**
+ * @brief Решение системы A * X = B для всех столбцов B сразу.
+ * @param b правая часть размера [n x m]
+ */
+template <typename T>
+S21MatrixT<T> S21LUT<T>::Solve(const S21MatrixT<T>& b) const {
+  S21MatrixT<T> x(b);
+  SolveInPlace(x);
+  return x;
+}
+
+template <typename T>
+std::vector<T> S21LUT<T>::Solve(const std::vector<T>& b) const {
+  if (static_cast<int>(b.size()) != GetSize()) {
+    throw std::invalid_argument(
+        "Incorrect input, right-hand side should have the same rows count");
+  }
+  std::vector<T> x(b);
+  Permute(x.data(), 1);
+  Substitute(x.data(), 1);
+  return x;
+}
+
+/**
+ * @brief Решение A * X = B с записью X поверх B.
+ * @details Не выделяет память - подходит для многократных решений
+ * в цикле с одним и тем же буфером правой части.
+ */
+template <typename T>
+void S21LUT<T>::SolveInPlace(S21MatrixT<T>& b) const {
+  if (b.GetRows() != GetSize() || b.GetCols() < 1) {
+    throw std::invalid_argument(
+        "Incorrect input, right-hand side should have the same rows count");
+  }
+  Permute(b.Data(), b.GetCols());
+  Substitute(b.Data(), b.GetCols());
+}
+
+/**
+ * @brief Обратная матрица как решение A * X = E.
+ * @details Единичная матрица строится сразу в буфере результата,
+ * перестановка и подстановки идут в нём же - других аллокаций нет.
+ */
+template <typename T>
+S21MatrixT<T> S21LUT<T>::InverseMatrix() const {
+  int size = GetSize();
+  S21MatrixT<T> x(size, size);
+  for (int i = 0; i < size; ++i) {
+    x(i, i) = T(1);
+  }
+  SolveInPlace(x);
+  return x;
+}
+
+/**
+ * @brief Применение к строкам правой части тех же перестановок, что
+ * были сделаны при разложении.
+ */
+template <typename T>
+void S21LUT<T>::Permute(T* rows, int cols) const noexcept {
+  for (int i = 0; i < GetSize(); ++i) {
+    if (pivots_[i] != i) {
+      std::swap_ranges(rows + i * cols, rows + (i + 1) * cols,
+                       rows + pivots_[i] * cols);
+    }
+  }
+}
+
+/**
+ * @brief Прямой (L) и обратный (U) ход на месте.
+ * @details Строки x уже переставлены согласно P. Обе подстановки - блочные
+ * s21::TriangularSolve, столбцы правой части делятся между потоками.
+ */
+template <typename T>
+void S21LUT<T>::Substitute(T* res, int cols) const {
+  if (singular_) {
+    throw std::invalid_argument("Determinant for this matrix is equal 0.");
+  }
+  const int size = GetSize();
+  s21::TriangularSolve(true, true, size, cols, lu_.Data(), size, 1, res,
+                       cols);
+  s21::TriangularSolve(false, false, size, cols, lu_.Data(), size, 1, res,
+                       cols);
+}
+
+/**
+ * @brief Решение A^T * x = b на месте для одного столбца.
+ * @details A^T = U^T * L^T * P: прямой ход с U^T, обратный с L^T и
+ * перестановки в обратном порядке. Обе подстановки идут по строкам
+ * разложения, как и Substitute.
+ */
+template <typename T>
+void S21LUT<T>::SubstituteTransposed(T* x) const noexcept {
+  const int size = GetSize();
+  const T* lu = lu_.Data();
+  for (int k = 0; k < size; ++k) {
+    const T* row = lu + static_cast<std::size_t>(k) * size;
+    x[k] /= row[k];
+    for (int i = k + 1; i < size; ++i) {
+      x[i] -= row[i] * x[k];
+    }
+  }
+  for (int k = size - 1; k > 0; --k) {
+    const T* row = lu + static_cast<std::size_t>(k) * size;
+    for (int i = 0; i < k; ++i) {
+      x[i] -= row[i] * x[k];
+    }
+  }
+  for (int i = size - 1; i >= 0; --i) {
+    std::swap(x[i], x[pivots_[i]]);
+  }
+}
+
+template class S21LUT<float>;
+template class S21LUT<double>;
+template class S21LUT<long double>;
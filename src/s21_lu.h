@@ -0,0 +1,75 @@
+#ifndef __S21LU_H__
+#define __S21LU_H__
+
+#include <type_traits>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+/**
+ * @brief LU-разложение с частичным выбором главного элемента: P * A = L * U.
+ * @details
+ * Разложение считается один раз за O(n^3) блочным алгоритмом с
+ * обновлениями через s21::Gemm в пуле потоков и хранится в одной матрице:
+ * под диагональю лежат множители L (диагональ L единичная), на диагонали
+ * и выше - U. После этого определитель берётся за O(n), решение системы -
+ * за O(n^2) на каждый столбец правой части, обратная матрица - за O(n^3)
+ * без дополнительных буферов. Объект неизменяем после построения, поэтому
+ * одно разложение можно использовать для любого числа правых частей,
+ * в том числе из нескольких потоков. Определено для float, double и
+ * long double (S21LU - для double). Вырожденной считается матрица с
+ * нулевым ведущим элементом, близость к вырожденной оценивает
+ * ReciprocalCondition.
+ */
+template <typename T>
+class S21LUT final {
+  static_assert(std::is_floating_point<T>::value,
+                "LU decomposition needs a floating point element type");
+
+ private:
+  S21MatrixT<T> lu_;
+  std::vector<int> pivots_;
+  int sign_;
+  bool singular_;
+  // 1-норма исходной матрицы
+  T norm_;
+
+  void Permute(T* rows, int cols) const noexcept;
+  void Substitute(T* x, int cols) const;
+  void SubstituteTransposed(T* x) const noexcept;
+
+ public:
+  explicit S21LUT(const S21MatrixT<T>& matrix);
+
+  int GetSize() const noexcept;
+  bool IsSingular() const noexcept;
+  T Determinant() const noexcept;
+  /**
+   * @brief ln|det A| и знак определителя (1, -1 или 0) без вычисления
+   * самого определителя.
+   * @details Сумма логарифмов диагонали U не переполняется при любом
+   * размере матрицы, det A = GetSign() * exp(LogAbsDeterminant()). Для
+   * вырожденной матрицы - минус бесконечность и знак 0.
+   */
+  T LogAbsDeterminant() const noexcept;
+  int GetSign() const noexcept;
+  /**
+   * @brief Оценка обратного числа обусловленности в 1-норме за O(n^2).
+   * @details Близко к 0 - матрица плохо обусловлена: обратная и решения
+   * систем теряют около -log10(rcond) верных знаков, а при rcond меньше
+   * машинного эпсилон не имеют смысла. 0 для вырожденной матрицы.
+   */
+  T ReciprocalCondition() const;
+  S21MatrixT<T> Solve(const S21MatrixT<T>& b) const;
+  std::vector<T> Solve(const std::vector<T>& b) const;
+  void SolveInPlace(S21MatrixT<T>& b) const;
+  S21MatrixT<T> InverseMatrix() const;
+};
+
+using S21LU = S21LUT<double>;
+
+extern template class S21LUT<float>;
+extern template class S21LUT<double>;
+extern template class S21LUT<long double>;
+
+#endif  //__S21LU_H__
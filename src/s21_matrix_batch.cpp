@@ -0,0 +1,593 @@
+#include "s21_matrix_batch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "s21_simd.h"
+#include "s21_thread_pool.h"
+
+namespace {
+template <typename T>
+constexpr int kLanesOf = S21MatrixBatchT<T>::kLanes;
+// Групп на одну задачу пула
+constexpr std::size_t kGroupsPerTask = 64;
+// Наборы с меньшим числом умножений считаются в одном потоке
+constexpr std::size_t kParallelWork = std::size_t(1) << 18;
+
+// Элемент (row, col) всех матриц группы
+template <typename T>
+inline T* At(T* group, int cols, int row, int col) noexcept {
+  return group + (static_cast<std::size_t>(row) * cols + col) *
+                     kLanesOf<std::remove_const_t<T>>;
+}
+
+/**
+ * @brief Выбор главного элемента в столбце k для каждой матрицы группы.
+ * @details Поиск максимума по модулю идёт векторно сразу по всей
+ * группе. Ведущие строки у разных матриц разные, поэтому обмен строк
+ * делается по одной матрице и только там, где он нужен. Столбцы w левее
+ * k уже исключены и не переставляются, строки x меняются целиком. sign
+ * меняет знак у матриц, где строки переставлены.
+ */
+template <typename T>
+__attribute__((always_inline)) inline void PivotLanes(T* w, T* x, int n,
+                                                      int k,
+                                                      T* sign) noexcept {
+  constexpr int kLanes = kLanesOf<T>;
+  T best[kLanes];
+  int pivot[kLanes];
+  const T* head = At(w, n, k, k);
+  for (int l = 0; l < kLanes; ++l) {
+    best[l] = std::fabs(head[l]);
+    pivot[l] = k;
+  }
+  for (int r = k + 1; r < n; ++r) {
+    const T* column = At(w, n, r, k);
+    for (int l = 0; l < kLanes; ++l) {
+      const T value = std::fabs(column[l]);
+      pivot[l] = value > best[l] ? r : pivot[l];
+      best[l] = value > best[l] ? value : best[l];
+    }
+  }
+  for (int l = 0; l < kLanes; ++l) {
+    if (pivot[l] == k) {
+      continue;
+    }
+    for (int c = k; c < n; ++c) {
+      std::swap(At(w, n, k, c)[l], At(w, n, pivot[l], c)[l]);
+    }
+    for (int c = 0; x != nullptr && c < n; ++c) {
+      std::swap(At(x, n, k, c)[l], At(x, n, pivot[l], c)[l]);
+    }
+    if (sign != nullptr) {
+      sign[l] = -sign[l];
+    }
+  }
+}
+
+/**
+ * @brief Ведущие элементы шага: запоминает вырожденные матрицы и
+ * возвращает обратные значения.
+ * @details Вырожденной, как в S21LU, считается матрица с нулевым или не
+ * конечным ведущим элементом. Вместо такого элемента берётся 1, чтобы
+ * вырожденные матрицы и нулевые матрицы дополнения не давали inf и NaN
+ * в соседних вычислениях.
+ */
+template <typename T>
+__attribute__((always_inline)) inline void PivotInverse(const T* pivot,
+                                                        T* singular,
+                                                        T* inverse) noexcept {
+  constexpr T kLargest = std::numeric_limits<T>::max();
+  for (int l = 0; l < kLanesOf<T>; ++l) {
+    const T value = std::fabs(pivot[l]);
+    const bool bad = !(value > T(0) && value <= kLargest);
+    singular[l] = bad ? T(1) : singular[l];
+    inverse[l] = T(1) / (bad ? T(1) : pivot[l]);
+  }
+}
+
+/**
+ * @brief 1-норма каждой матрицы группы.
+ * @details Нужна для обратного числа обусловленности в BatchInverse:
+ * норма A^-1 там известна точно, оценка как в S21LU не нужна.
+ */
+template <typename T>
+__attribute__((always_inline)) inline void NormLanes(const T* group, int n,
+                                                     T* norm) noexcept {
+  constexpr int kLanes = kLanesOf<T>;
+  std::fill_n(norm, kLanes, T(0));
+  for (int c = 0; c < n; ++c) {
+    T sum[kLanes] = {};
+    for (int r = 0; r < n; ++r) {
+      const T* value = At(group, n, r, c);
+      for (int l = 0; l < kLanes; ++l) {
+        sum[l] += std::fabs(value[l]);
+      }
+    }
+    for (int l = 0; l < kLanes; ++l) {
+      norm[l] = sum[l] > norm[l] ? sum[l] : norm[l];
+    }
+  }
+}
+
+/**
+ * @brief Действия над одним элементом всех kLanes матриц группы.
+ * @details Строки разные, поэтому аргументы не пересекаются: restrict
+ * позволяет компилятору свернуть цикл в одну векторную инструкцию без
+ * проверок наложения.
+ */
+template <typename T>
+__attribute__((always_inline)) inline void SubScaled(
+    T* __restrict dst, const T* __restrict coeff,
+    const T* __restrict src) noexcept {
+  for (int l = 0; l < kLanesOf<T>; ++l) {
+    dst[l] -= coeff[l] * src[l];
+  }
+}
+
+template <typename T>
+__attribute__((always_inline)) inline void Scale(
+    T* __restrict dst, const T* __restrict factor) noexcept {
+  for (int l = 0; l < kLanesOf<T>; ++l) {
+    dst[l] *= factor[l];
+  }
+}
+
+// res[g] = a[g] * b[g] для всех матриц группы
+template <typename T>
+struct MulGroup {
+  using Value = T;
+  static constexpr int kLanes = kLanesOf<T>;
+
+  const T* a;
+  const T* b;
+  T* res;
+  int rows, inner, cols;
+
+  std::size_t ScratchSize() const noexcept { return 0; }
+
+  __attribute__((always_inline)) void operator()(std::size_t group,
+                                                 T*) const {
+    const T* ga = a + group * rows * inner * kLanes;
+    const T* gb = b + group * inner * cols * kLanes;
+    T* gr = res + group * rows * cols * kLanes;
+    for (int i = 0; i < rows; ++i) {
+      for (int j = 0; j < cols; ++j) {
+        T acc[kLanes] = {};
+        for (int k = 0; k < inner; ++k) {
+          const T* x = At(ga, inner, i, k);
+          const T* y = At(gb, cols, k, j);
+          for (int l = 0; l < kLanes; ++l) {
+            acc[l] += x[l] * y[l];
+          }
+        }
+        std::copy_n(acc, kLanes, At(gr, cols, i, j));
+      }
+    }
+  }
+};
+
+// Определители матриц группы прямым ходом метода Гаусса
+template <typename T>
+struct DeterminantGroup {
+  using Value = T;
+  static constexpr int kLanes = kLanesOf<T>;
+
+  const T* a;
+  T* det;
+  int n;
+
+  std::size_t ScratchSize() const noexcept {
+    return static_cast<std::size_t>(n) * n * kLanes;
+  }
+
+  __attribute__((always_inline)) void operator()(std::size_t group,
+                                                 T* w) const {
+    std::copy_n(a + group * ScratchSize(), ScratchSize(), w);
+    T res[kLanes], singular[kLanes] = {}, inverse[kLanes];
+    std::fill_n(res, kLanes, T(1));
+    for (int k = 0; k < n; ++k) {
+      PivotLanes<T>(w, nullptr, n, k, res);
+      const T* pivot = At(w, n, k, k);
+      PivotInverse(pivot, singular, inverse);
+      Scale(res, pivot);
+      for (int r = k + 1; r < n; ++r) {
+        T coeff[kLanes];
+        std::copy_n(At(w, n, r, k), kLanes, coeff);
+        Scale(coeff, inverse);
+        for (int c = k + 1; c < n; ++c) {
+          SubScaled(At(w, n, r, c), coeff, At(w, n, k, c));
+        }
+      }
+    }
+    for (int l = 0; l < kLanes; ++l) {
+      det[group * kLanes + l] = singular[l] != T(0) ? T(0) : res[l];
+    }
+  }
+};
+
+// Обратные матрицы группы методом Гаусса-Жордана
+template <typename T>
+struct InverseGroup {
+  using Value = T;
+  static constexpr int kLanes = kLanesOf<T>;
+
+  const T* a;
+  T* res;
+  T* singular;
+  int n;
+
+  std::size_t ScratchSize() const noexcept {
+    return static_cast<std::size_t>(n) * n * kLanes;
+  }
+
+  __attribute__((always_inline)) void operator()(std::size_t group,
+                                                 T* w) const {
+    std::copy_n(a + group * ScratchSize(), ScratchSize(), w);
+    T* x = res + group * ScratchSize();
+    std::fill_n(x, ScratchSize(), T(0));
+    for (int i = 0; i < n; ++i) {
+      std::fill_n(At(x, n, i, i), kLanes, T(1));
+    }
+    T* flags = singular + group * kLanes;
+    for (int k = 0; k < n; ++k) {
+      PivotLanes<T>(w, x, n, k, nullptr);
+      T inverse[kLanes];
+      PivotInverse(At(w, n, k, k), flags, inverse);
+      for (int c = k + 1; c < n; ++c) {
+        Scale(At(w, n, k, c), inverse);
+      }
+      for (int c = 0; c < n; ++c) {
+        Scale(At(x, n, k, c), inverse);
+      }
+      for (int r = 0; r < n; ++r) {
+        if (r == k) {
+          continue;
+        }
+        T coeff[kLanes];
+        std::copy_n(At(w, n, r, k), kLanes, coeff);
+        // Столбец k у w после шага нулевой и дальше не читается
+        for (int c = k + 1; c < n; ++c) {
+          SubScaled(At(w, n, r, c), coeff, At(w, n, k, c));
+        }
+        for (int c = 0; c < n; ++c) {
+          SubScaled(At(x, n, r, c), coeff, At(x, n, k, c));
+        }
+      }
+    }
+    // Вырождена с точностью до эпсилон, как в InverseMatrix:
+    // 1 / (||A||_1 * ||A^-1||_1) < eps
+    constexpr T kLimit = T(1) / std::numeric_limits<T>::epsilon();
+    T norm_a[kLanes], norm_x[kLanes];
+    NormLanes(a + group * ScratchSize(), n, norm_a);
+    NormLanes(x, n, norm_x);
+    for (int l = 0; l < kLanes; ++l) {
+      flags[l] = norm_a[l] * norm_x[l] <= kLimit ? flags[l] : T(1);
+    }
+  }
+};
+
+/**
+ * @brief Обработка групп [first, last).
+ * @details Операции встраиваются в каждый из вариантов ниже и
+ * компилируются под его набор инструкций: циклы по kLanes матрицам
+ * группы становятся векторными инструкциями нужной ширины.
+ */
+template <typename Op, typename T = typename Op::Value>
+void ForGroups(const Op& op, std::size_t first, std::size_t last,
+               T* scratch) {
+  for (std::size_t group = first; group < last; ++group) {
+    op(group, scratch);
+  }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+template <typename Op, typename T = typename Op::Value>
+__attribute__((target("avx2"))) void ForGroupsAvx2(const Op& op,
+                                                   std::size_t first,
+                                                   std::size_t last,
+                                                   T* scratch) {
+  for (std::size_t group = first; group < last; ++group) {
+    op(group, scratch);
+  }
+}
+
+template <typename Op, typename T = typename Op::Value>
+__attribute__((target("avx512f"))) void ForGroupsAvx512(const Op& op,
+                                                        std::size_t first,
+                                                        std::size_t last,
+                                                        T* scratch) {
+  for (std::size_t group = first; group < last; ++group) {
+    op(group, scratch);
+  }
+}
+#endif
+
+/**
+ * @brief Запуск операции по всем группам набора.
+ * @details Вариант выбирается по уровню s21::GetKernels(), так что
+ * s21::SetSimdLevel действует и на пакетные операции. Крупные наборы
+ * делятся на задачи по kGroupsPerTask групп для пула потоков.
+ * @param work оценка числа умножений на весь набор
+ */
+template <typename Op>
+void Run(const Op& op, std::size_t groups, std::size_t work) {
+  using T = typename Op::Value;
+  const s21::SimdLevel level = s21::GetKernels<T>().level;
+  auto range = [&op, level](std::size_t first, std::size_t last) {
+    std::vector<T> scratch(op.ScratchSize());
+#if defined(__x86_64__) || defined(__i386__)
+    if (level == s21::SimdLevel::kAvx512) {
+      ForGroupsAvx512(op, first, last, scratch.data());
+    } else if (level == s21::SimdLevel::kAvx2) {
+      ForGroupsAvx2(op, first, last, scratch.data());
+    } else {
+      ForGroups(op, first, last, scratch.data());
+    }
+#else
+    (void)level;
+    ForGroups(op, first, last, scratch.data());
+#endif
+  };
+  s21::ThreadPool& pool = s21::ThreadPool::Global();
+  if (pool.GetThreadCount() == 1 || work < kParallelWork ||
+      groups <= kGroupsPerTask) {
+    range(0, groups);
+  } else {
+    const int tasks =
+        static_cast<int>((groups + kGroupsPerTask - 1) / kGroupsPerTask);
+    pool.ParallelFor(tasks, [&](int task) {
+      const std::size_t first = task * kGroupsPerTask;
+      range(first, std::min(groups, first + kGroupsPerTask));
+    });
+  }
+}
+}  // namespace
+
+template <typename T>
+S21MatrixBatchT<T>::S21MatrixBatchT() noexcept
+    : count_(0), rows_(0), cols_(0), data_(nullptr) {}
+
+/**
+ * @brief Набор из count нулевых матриц [rows x cols].
+ */
+template <typename T>
+S21MatrixBatchT<T>::S21MatrixBatchT(std::size_t count, int rows, int cols)
+    : count_(count), rows_(rows), cols_(cols), data_(nullptr) {
+  if (rows < 0 || cols < 0) {
+    throw std::length_error("Matrix size must be greater than 0");
+  }
+  data_ = s21::AllocateBuffer<T>(GetBufferSize());
+  s21::GetKernels<T>().zero(data_, GetBufferSize());
+}
+
+template <typename T>
+S21MatrixBatchT<T>::S21MatrixBatchT(const S21MatrixBatchT& other)
+    : count_(other.count_),
+      rows_(other.rows_),
+      cols_(other.cols_),
+      data_(nullptr) {
+  if (other.data_ != nullptr) {
+    data_ = s21::AllocateBuffer<T>(GetBufferSize());
+    std::copy_n(other.data_, GetBufferSize(), data_);
+  }
+}
+
+template <typename T>
+S21MatrixBatchT<T>::S21MatrixBatchT(S21MatrixBatchT&& other) noexcept
+    : count_(other.count_),
+      rows_(other.rows_),
+      cols_(other.cols_),
+      data_(other.data_) {
+  other.count_ = 0;
+  other.rows_ = 0;
+  other.cols_ = 0;
+  other.data_ = nullptr;
+}
+
+template <typename T>
+S21MatrixBatchT<T>& S21MatrixBatchT<T>::operator=(
+    const S21MatrixBatchT& other) {
+  if (this != &other) {
+    S21MatrixBatchT copy(other);
+    *this = std::move(copy);
+  }
+  return *this;
+}
+
+template <typename T>
+S21MatrixBatchT<T>& S21MatrixBatchT<T>::operator=(
+    S21MatrixBatchT&& other) noexcept {
+  if (this != &other) {
+    s21::FreeBuffer(data_);
+    count_ = other.count_;
+    rows_ = other.rows_;
+    cols_ = other.cols_;
+    data_ = other.data_;
+    other.count_ = 0;
+    other.rows_ = 0;
+    other.cols_ = 0;
+    other.data_ = nullptr;
+  }
+  return *this;
+}
+
+template <typename T>
+S21MatrixBatchT<T>::~S21MatrixBatchT() {
+  s21::FreeBuffer(data_);
+}
+
+// Размер буфера в элементах вместе с дополнением последней группы
+template <typename T>
+std::size_t S21MatrixBatchT<T>::GetBufferSize() const noexcept {
+  return GetGroupCount() * rows_ * cols_ * kLanes;
+}
+
+template <typename T>
+std::size_t S21MatrixBatchT<T>::GetCount() const noexcept {
+  return count_;
+}
+
+template <typename T>
+std::size_t S21MatrixBatchT<T>::GetGroupCount() const noexcept {
+  return (count_ + kLanes - 1) / kLanes;
+}
+
+template <typename T>
+int S21MatrixBatchT<T>::GetRows() const noexcept {
+  return rows_;
+}
+
+template <typename T>
+int S21MatrixBatchT<T>::GetCols() const noexcept {
+  return cols_;
+}
+
+template <typename T>
+T* S21MatrixBatchT<T>::Data() noexcept {
+  return data_;
+}
+
+template <typename T>
+const T* S21MatrixBatchT<T>::Data() const noexcept {
+  return data_;
+}
+
+template <typename T>
+T& S21MatrixBatchT<T>::operator()(std::size_t index, int row,
+                                  int col) noexcept {
+  const std::size_t group = index / kLanes;
+  return At(data_ + group * rows_ * cols_ * kLanes, cols_, row,
+            col)[index % kLanes];
+}
+
+template <typename T>
+T S21MatrixBatchT<T>::operator()(std::size_t index, int row,
+                                 int col) const noexcept {
+  const std::size_t group = index / kLanes;
+  return At(data_ + group * rows_ * cols_ * kLanes, cols_, row,
+            col)[index % kLanes];
+}
+
+// Копия матрицы index
+template <typename T>
+S21MatrixT<T> S21MatrixBatchT<T>::Get(std::size_t index) const {
+  if (index >= count_) {
+    throw std::out_of_range("Incorrect input, index is out of the batch");
+  }
+  S21MatrixT<T> res(rows_, cols_);
+  for (int i = 0; i < rows_; ++i) {
+    for (int j = 0; j < cols_; ++j) {
+      res(i, j) = (*this)(index, i, j);
+    }
+  }
+  return res;
+}
+
+template <typename T>
+void S21MatrixBatchT<T>::Set(std::size_t index, const S21MatrixT<T>& matrix) {
+  if (index >= count_) {
+    throw std::out_of_range("Incorrect input, index is out of the batch");
+  }
+  if (matrix.GetRows() != rows_ || matrix.GetCols() != cols_) {
+    throw std::out_of_range(
+        "Incorrect input, matricex should have the same size");
+  }
+  for (int i = 0; i < rows_; ++i) {
+    for (int j = 0; j < cols_; ++j) {
+      (*this)(index, i, j) = matrix(i, j);
+    }
+  }
+}
+
+template class S21MatrixBatchT<float>;
+template class S21MatrixBatchT<double>;
+
+namespace s21 {
+/**
+ * @brief Сумма наборов.
+ * @details Раскладка у наборов одинаковая, поэтому сумма - одно
+ * сложение буферов векторным ядром s21::GetKernels().
+ */
+template <typename T>
+S21MatrixBatchT<T> BatchSum(const S21MatrixBatchT<T>& a,
+                            const S21MatrixBatchT<T>& b) {
+  if (a.GetCount() != b.GetCount() || a.GetRows() != b.GetRows() ||
+      a.GetCols() != b.GetCols()) {
+    throw std::out_of_range(
+        "Incorrect input, matricex should have the same size");
+  }
+  S21MatrixBatchT<T> res(a);
+  GetKernels<T>().add(
+      res.Data(), b.Data(),
+      a.GetGroupCount() * a.GetRows() * a.GetCols() * kLanesOf<T>);
+  return res;
+}
+
+template <typename T>
+S21MatrixBatchT<T> BatchMulMatrix(const S21MatrixBatchT<T>& a,
+                                  const S21MatrixBatchT<T>& b) {
+  if (a.GetCount() != b.GetCount()) {
+    throw std::out_of_range(
+        "Incorrect input, batches should have the same count");
+  }
+  if (a.GetCols() != b.GetRows()) {
+    throw std::invalid_argument(
+        "Incorrect input, matricex should have format M1.cols_ = M2.rows_");
+  }
+  S21MatrixBatchT<T> res(a.GetCount(), a.GetRows(), b.GetCols());
+  MulGroup<T> op{a.Data(),    b.Data(),    res.Data(),
+                 a.GetRows(), a.GetCols(), b.GetCols()};
+  Run(op, a.GetGroupCount(),
+      a.GetCount() * a.GetRows() * a.GetCols() * b.GetCols());
+  return res;
+}
+
+template <typename T>
+std::vector<T> BatchDeterminant(const S21MatrixBatchT<T>& a) {
+  if (a.GetRows() != a.GetCols()) {
+    throw std::invalid_argument("Matrix should have square format.");
+  }
+  const int n = a.GetRows();
+  std::vector<T> det(a.GetGroupCount() * kLanesOf<T>);
+  Run(DeterminantGroup<T>{a.Data(), det.data(), n}, a.GetGroupCount(),
+      a.GetCount() * n * n * n / 3);
+  det.resize(a.GetCount());
+  return det;
+}
+
+template <typename T>
+S21MatrixBatchT<T> BatchInverse(const S21MatrixBatchT<T>& a) {
+  if (a.GetRows() < 1 || a.GetCols() < 1) {
+    throw std::out_of_range("Invalid matrix");
+  }
+  if (a.GetRows() != a.GetCols()) {
+    throw std::invalid_argument("Matrix should have square format.");
+  }
+  const int n = a.GetRows();
+  S21MatrixBatchT<T> res(a.GetCount(), n, n);
+  std::vector<T> singular(a.GetGroupCount() * kLanesOf<T>, T(0));
+  Run(InverseGroup<T>{a.Data(), res.Data(), singular.data(), n},
+      a.GetGroupCount(), a.GetCount() * n * n * n);
+  // Нулевые матрицы дополнения последней группы не в счёт
+  if (std::any_of(singular.begin(), singular.begin() + a.GetCount(),
+                  [](T flag) { return flag != T(0); })) {
+    throw std::invalid_argument("Determinant for this matrix is equal 0.");
+  }
+  return res;
+}
+
+#define S21_BATCH_INSTANTIATE(T)                                         \
+  template S21MatrixBatchT<T> BatchSum(const S21MatrixBatchT<T>& a,      \
+                                       const S21MatrixBatchT<T>& b);     \
+  template S21MatrixBatchT<T> BatchMulMatrix(                            \
+      const S21MatrixBatchT<T>& a, const S21MatrixBatchT<T>& b);         \
+  template std::vector<T> BatchDeterminant(const S21MatrixBatchT<T>& a); \
+  template S21MatrixBatchT<T> BatchInverse(const S21MatrixBatchT<T>& a);
+
+S21_BATCH_INSTANTIATE(float)
+S21_BATCH_INSTANTIATE(double)
+#undef S21_BATCH_INSTANTIATE
+}  // namespace s21
@@ -0,0 +1,96 @@
+#ifndef __S21MATRIXBATCH_H__
+#define __S21MATRIXBATCH_H__
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+/**
+ * @brief Набор из count матриц одного размера [rows x cols].
+ * @details
+ * Матрицы хранятся группами по kLanes: внутри группы подряд лежат
+ * элементы (i, j) всех kLanes матриц, затем элементы (i, j + 1) и т.д.
+ *
+ *   data[(group * rows * cols + i * cols + j) * kLanes + lane]
+ *
+ * Пакетные операции обрабатывают группу целиком: каждое действие
+ * алгоритма выполняется сразу для kLanes матриц одной векторной
+ * инструкцией, а группы раздаются потокам пула. Так миллионы матриц
+ * 2x2 - 8x8 обрабатываются без аллокаций и вызовов на каждую матрицу.
+ * Последняя группа дополняется нулевыми матрицами, которые в
+ * результатах не видны.
+ *
+ * Определено для float и double (S21MatrixBatch - для double). Группа -
+ * 64 байта, один регистр AVX-512: 8 матриц double или 16 матриц float.
+ */
+template <typename T>
+class S21MatrixBatchT final {
+  static_assert(std::is_same<T, float>::value ||
+                    std::is_same<T, double>::value,
+                "Batch operations need a float or double element type");
+
+ private:
+  std::size_t count_;
+  int rows_, cols_;
+  T* data_;
+
+  std::size_t GetBufferSize() const noexcept;
+
+ public:
+  static constexpr int kLanes = 64 / sizeof(T);
+
+  S21MatrixBatchT() noexcept;
+  explicit S21MatrixBatchT(std::size_t count, int rows, int cols);
+  S21MatrixBatchT(const S21MatrixBatchT& other);
+  S21MatrixBatchT(S21MatrixBatchT&& other) noexcept;
+  S21MatrixBatchT& operator=(const S21MatrixBatchT& other);
+  S21MatrixBatchT& operator=(S21MatrixBatchT&& other) noexcept;
+  ~S21MatrixBatchT();
+
+  std::size_t GetCount() const noexcept;
+  std::size_t GetGroupCount() const noexcept;
+  int GetRows() const noexcept;
+  int GetCols() const noexcept;
+  T* Data() noexcept;
+  const T* Data() const noexcept;
+
+  // Элемент (row, col) матрицы с номером index, границы не проверяются
+  T& operator()(std::size_t index, int row, int col) noexcept;
+  T operator()(std::size_t index, int row, int col) const noexcept;
+
+  S21MatrixT<T> Get(std::size_t index) const;
+  void Set(std::size_t index, const S21MatrixT<T>& matrix);
+};
+
+using S21MatrixBatch = S21MatrixBatchT<double>;
+using S21MatrixBatchF = S21MatrixBatchT<float>;
+
+extern template class S21MatrixBatchT<float>;
+extern template class S21MatrixBatchT<double>;
+
+namespace s21 {
+// Поэлементная сумма наборов одного размера
+template <typename T>
+S21MatrixBatchT<T> BatchSum(const S21MatrixBatchT<T>& a,
+                            const S21MatrixBatchT<T>& b);
+// Попарные произведения a[i] * b[i]
+template <typename T>
+S21MatrixBatchT<T> BatchMulMatrix(const S21MatrixBatchT<T>& a,
+                                  const S21MatrixBatchT<T>& b);
+// Определители всех матриц набора (0 для вырожденных, как S21LU)
+template <typename T>
+std::vector<T> BatchDeterminant(const S21MatrixBatchT<T>& a);
+/**
+ * @brief Обратные матрицы всех матриц набора.
+ * @details Если хотя бы одна матрица вырождена, выбрасывается
+ * std::invalid_argument, как в S21Matrix::InverseMatrix. Признак
+ * вырожденности тот же: нулевой ведущий элемент (как у BatchDeterminant)
+ * или обратное число обусловленности в 1-норме меньше машинного эпсилон.
+ */
+template <typename T>
+S21MatrixBatchT<T> BatchInverse(const S21MatrixBatchT<T>& a);
+}  // namespace s21
+
+#endif  //__S21MATRIXBATCH_H__
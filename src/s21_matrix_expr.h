@@ -0,0 +1,465 @@
+#ifndef __S21MATRIXEXPR_H__
+#define __S21MATRIXEXPR_H__
+
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "s21_matrix_oop.h"
+
+/**
+ * Ленивые выражения над матрицами (expression templates).
+ *
+ * Операторы +, - и умножение на число не считают результат сразу, а
+ * возвращают лёгкий узел дерева выражения. Всё дерево вычисляется одним
+ * проходом по памяти в момент присваивания или создания S21Matrix, без
+ * промежуточных матриц: A + B - C * 2.0 - одна аллокация и один цикл.
+ *
+ * Операнды-lvalue хранятся в узлах по ссылке, временные - по значению:
+ * вложенный узел перемещается в родителя, константная временная матрица
+ * копируется в лист. Поэтому auto e = A + B * 2.0 не ссылается на
+ * уничтоженные узлы, но живёт не дольше матриц A и B. Узел только
+ * читается: изменяемую матрицу даёт S21Matrix m = A + B.
+ *
+ * Если один из операндов - временная S21Matrix (например, результат
+ * A * B), узел не строится: операция выполняется на месте в буфере этого
+ * операнда, и он же возвращается перемещением. (A * B) + C - D * 2.0
+ * выделяет память только под произведение.
+ *
+ * Произведение матриц по-прежнему считается сразу и возвращает S21Matrix.
+ *
+ * Узлы работают с матрицами любого типа элементов, но оба операнда
+ * должны иметь один и тот же тип: сложение S21MatrixF и S21Matrix не
+ * компилируется.
+ */
+namespace s21 {
+template <typename T>
+struct IsMatrix : std::false_type {};
+
+template <typename T>
+struct IsMatrix<S21MatrixT<T>> : std::true_type {};
+
+// Тип элементов матрицы или узла выражения
+template <typename T>
+using ValueOf = typename std::decay_t<T>::value_type;
+
+template <typename T>
+using IsMatrixOperand =
+    std::integral_constant<bool, IsExprNode<std::decay_t<T>>::value ||
+                                     IsMatrix<std::decay_t<T>>::value>;
+
+// Операнд - временная неконстантная матрица, её буфер можно забрать.
+// Для ссылки пересылки T выводится как S21MatrixT<U> только у rvalue.
+template <typename T>
+using IsExpiringMatrix = IsMatrix<T>;
+
+template <typename L, typename R>
+using IsLazyPair = std::integral_constant<
+    bool, IsMatrixOperand<L>::value && IsMatrixOperand<R>::value &&
+              !IsExpiringMatrix<L>::value && !IsExpiringMatrix<R>::value>;
+
+template <typename L, typename R>
+using IsInPlacePair = std::integral_constant<
+    bool, IsMatrixOperand<L>::value && IsMatrixOperand<R>::value &&
+              (IsExpiringMatrix<L>::value || IsExpiringMatrix<R>::value)>;
+
+// Временная матрица пары, в буфере которой считается результат
+template <typename L, typename R>
+using ExpiringOf = std::conditional_t<IsExpiringMatrix<L>::value, L, R>;
+
+/**
+ * @brief Область памяти: элемент (i, j) лежит по адресу
+ * data + i * row_stride + j * col_stride.
+ */
+template <typename T>
+struct Footprint {
+  const T* data;
+  int rows, cols;
+  int row_stride, col_stride;
+};
+
+/**
+ * @brief Мешает ли чтение области src записи результата в dst.
+ * @details Поэлементное вычисление читает элемент (i, j) операндов до
+ * записи в (i, j) результата, поэтому совпадающие области безопасны.
+ * Любое другое пересечение (блок той же матрицы, транспонированное
+ * представление) требует вычисления через временную матрицу.
+ */
+template <typename T>
+bool Conflicts(const Footprint<T>& src, const Footprint<T>& dst) noexcept {
+  if (src.rows == 0 || src.cols == 0 || dst.rows == 0 || dst.cols == 0) {
+    return false;
+  }
+  const T* src_last = src.data +
+                           static_cast<std::ptrdiff_t>(src.rows - 1) *
+                               src.row_stride +
+                           static_cast<std::ptrdiff_t>(src.cols - 1) *
+                               src.col_stride;
+  const T* dst_last = dst.data +
+                           static_cast<std::ptrdiff_t>(dst.rows - 1) *
+                               dst.row_stride +
+                           static_cast<std::ptrdiff_t>(dst.cols - 1) *
+                               dst.col_stride;
+  bool same = src.data == dst.data && src.rows == dst.rows &&
+              src.cols == dst.cols &&
+              (src.rows == 1 || src.row_stride == dst.row_stride) &&
+              (src.cols == 1 || src.col_stride == dst.col_stride);
+  return !same && src.data <= dst_last && dst.data <= src_last;
+}
+
+/**
+ * @brief CRTP-база узлов выражения.
+ * @details Повторяет константную часть интерфейса S21Matrix, чтобы
+ * выражения вроде (A + B).Determinant() собирались как и раньше.
+ */
+template <typename Derived, typename T = double>
+class MatrixExpr : public MatrixExprTag {
+ public:
+  using value_type = T;
+
+  const Derived& Self() const noexcept {
+    return static_cast<const Derived&>(*this);
+  }
+
+  S21MatrixT<T> Eval() const { return S21MatrixT<T>(Self()); }
+  bool EqMatrix(const S21MatrixT<T>& other) const {
+    return Eval().EqMatrix(other);
+  }
+  S21MatrixT<T> Transpose() const { return Eval().Transpose(); }
+  S21MatrixT<T> CalcComplements() const { return Eval().CalcComplements(); }
+  T Determinant() const { return Eval().Determinant(); }
+  S21MatrixT<T> InverseMatrix() const { return Eval().InverseMatrix(); }
+};
+
+/**
+ * @brief Лист выражения - ссылка на существующую матрицу.
+ * @details Указатель на данные запоминается один раз, доступ к элементу
+ * в цикле вычисления встраивается компилятором.
+ */
+template <typename T>
+class MatrixLeaf final : public MatrixExpr<MatrixLeaf<T>, T> {
+ private:
+  const T* data_;
+  int rows_, cols_;
+
+ public:
+  explicit MatrixLeaf(const S21MatrixT<T>& matrix)
+      : data_(matrix.Data()), rows_(matrix.GetRows()),
+        cols_(matrix.GetCols()) {}
+
+  int GetRows() const noexcept { return rows_; }
+  int GetCols() const noexcept { return cols_; }
+  T operator()(int row, int col) const noexcept {
+    return data_[static_cast<std::size_t>(row) * cols_ + col];
+  }
+  bool MayAlias(const Footprint<T>& dst) const noexcept {
+    return Conflicts({data_, rows_, cols_, cols_, 1}, dst);
+  }
+};
+
+/**
+ * @brief Лист выражения, владеющий копией константной временной матрицы.
+ * @details Буфер const rvalue забрать нельзя, а ссылка на него повисла
+ * бы в узле, сохранённом через auto.
+ */
+template <typename T>
+class MatrixValue final : public MatrixExpr<MatrixValue<T>, T> {
+ private:
+  S21MatrixT<T> matrix_;
+
+ public:
+  explicit MatrixValue(const S21MatrixT<T>& matrix) : matrix_(matrix) {}
+
+  int GetRows() const noexcept { return matrix_.GetRows(); }
+  int GetCols() const noexcept { return matrix_.GetCols(); }
+  T operator()(int row, int col) const noexcept {
+    return matrix_.Data()[static_cast<std::size_t>(row) * matrix_.GetCols() +
+                          col];
+  }
+  // Собственный буфер не может быть буфером результата
+  bool MayAlias(const Footprint<T>&) const noexcept { return false; }
+};
+
+// Как операнд T хранится внутри узла: узлы - по значению, матрицы-lvalue -
+// ссылкой через лист, константные временные матрицы - копией
+template <typename T, bool = IsExprNode<std::decay_t<T>>::value>
+struct OperandOf {
+  using type = std::decay_t<T>;
+};
+
+template <typename T>
+struct OperandOf<T, false> {
+  using type = std::conditional_t<std::is_reference<T>::value,
+                                  MatrixLeaf<ValueOf<T>>,
+                                  MatrixValue<ValueOf<T>>>;
+};
+
+template <typename T>
+using OperandOfT = typename OperandOf<T>::type;
+
+/**
+ * @brief Поэлементная бинарная операция Op над двумя выражениями.
+ * @details Размеры проверяются при построении узла, поэтому исключение
+ * выбрасывается там же, где его выбрасывали прежние операторы.
+ */
+template <typename Op, typename L, typename R>
+class MatrixBinaryExpr final
+    : public MatrixExpr<MatrixBinaryExpr<Op, L, R>, typename L::value_type> {
+  static_assert(std::is_same<typename L::value_type,
+                             typename R::value_type>::value,
+                "Operands must have the same element type");
+
+ private:
+  L lhs_;
+  R rhs_;
+
+ public:
+  template <typename LA, typename RA>
+  MatrixBinaryExpr(LA&& lhs, RA&& rhs)
+      : lhs_(std::forward<LA>(lhs)), rhs_(std::forward<RA>(rhs)) {
+    if (lhs_.GetRows() != rhs_.GetRows() ||
+        lhs_.GetCols() != rhs_.GetCols()) {
+      throw std::out_of_range(
+          "Incorrect input, matricex should have the same size");
+    }
+  }
+
+  int GetRows() const noexcept { return lhs_.GetRows(); }
+  int GetCols() const noexcept { return lhs_.GetCols(); }
+  typename L::value_type operator()(int row, int col) const {
+    return Op()(lhs_(row, col), rhs_(row, col));
+  }
+  bool MayAlias(const Footprint<typename L::value_type>& dst) const noexcept {
+    return lhs_.MayAlias(dst) || rhs_.MayAlias(dst);
+  }
+};
+
+// Умножение выражения на число
+template <typename E>
+class MatrixScaleExpr final
+    : public MatrixExpr<MatrixScaleExpr<E>, typename E::value_type> {
+ private:
+  using T = typename E::value_type;
+
+  E expr_;
+  T num_;
+
+ public:
+  template <typename EA>
+  MatrixScaleExpr(EA&& expr, T num)
+      : expr_(std::forward<EA>(expr)), num_(num) {}
+
+  int GetRows() const noexcept { return expr_.GetRows(); }
+  int GetCols() const noexcept { return expr_.GetCols(); }
+  T operator()(int row, int col) const { return expr_(row, col) * num_; }
+  bool MayAlias(const Footprint<T>& dst) const noexcept {
+    return expr_.MayAlias(dst);
+  }
+};
+
+/**
+ * @brief Вычисление выражения в плотный буфер dst со строками длины cols.
+ * @details Поэлементные узлы читают только элемент (i, j) операндов,
+ * поэтому dst может совпадать с буфером одного из операндов (но не
+ * пересекаться с ним иначе - см. Conflicts).
+ */
+template <typename E>
+void EvaluateInto(const E& expr, typename E::value_type* dst) {
+  const int rows = expr.GetRows();
+  const int cols = expr.GetCols();
+  for (int i = 0; i < rows; ++i) {
+    typename E::value_type* row = dst + static_cast<std::size_t>(i) * cols;
+    for (int j = 0; j < cols; ++j) {
+      row[j] = expr(i, j);
+    }
+  }
+}
+
+/**
+ * @brief Операнд в виде, пригодном для произведения и сравнения.
+ * @details Выражение вычисляется во временную матрицу, готовая матрица
+ * (и представление, см. s21_matrix_view.h) передаётся без копии.
+ * Специализации шаблона видны в момент инстанцирования, поэтому
+ * типы, объявленные позже, тоже могут их добавлять.
+ */
+template <typename T>
+struct Materializer {
+  static S21MatrixT<ValueOf<T>> Get(const T& expr) {
+    return S21MatrixT<ValueOf<T>>(expr);
+  }
+};
+
+template <typename T>
+struct Materializer<S21MatrixT<T>> {
+  static const S21MatrixT<T>& Get(const S21MatrixT<T>& matrix) {
+    return matrix;
+  }
+};
+
+template <typename T>
+decltype(auto) Materialize(const T& operand) {
+  return Materializer<T>::Get(operand);
+}
+}  // namespace s21
+
+template <typename T>
+template <typename E, typename>
+S21MatrixT<T>::S21MatrixT(const E& expr)
+    : rows_(expr.GetRows()), cols_(expr.GetCols()) {
+  static_assert(std::is_same<typename E::value_type, T>::value,
+                "Expression must have the same element type");
+  this->AllocateMatrix();
+  s21::EvaluateInto(expr, matrix_);
+}
+
+/**
+ * @brief Присваивание выражения.
+ * @details Если буфера this хватает и выражение не читает его иначе, чем
+ * поэлементно, выражение вычисляется прямо в буфер без аллокаций.
+ */
+template <typename T>
+template <typename E, typename>
+S21MatrixT<T>& S21MatrixT<T>::operator=(const E& expr) {
+  static_assert(std::is_same<typename E::value_type, T>::value,
+                "Expression must have the same element type");
+  std::size_t count =
+      static_cast<std::size_t>(expr.GetRows()) * expr.GetCols();
+  if (matrix_ != nullptr && count <= capacity_ &&
+      !expr.MayAlias({matrix_, expr.GetRows(), expr.GetCols(),
+                      expr.GetCols(), 1})) {
+    rows_ = expr.GetRows();
+    cols_ = expr.GetCols();
+    s21::EvaluateInto(expr, matrix_);
+  } else {
+    *this = S21MatrixT(expr);
+  }
+  return *this;
+}
+
+template <typename T>
+template <typename E, typename>
+S21MatrixT<T>& S21MatrixT<T>::operator+=(const E& expr) {
+  if (rows_ != expr.GetRows() || cols_ != expr.GetCols()) {
+    throw std::out_of_range(
+        "Incorrect input, matricex should have the same size");
+  }
+  if (expr.MayAlias({matrix_, rows_, cols_, cols_, 1})) {
+    return *this += S21MatrixT(expr);
+  }
+  for (int i = 0; i < rows_; ++i) {
+    T* row = matrix_ + static_cast<std::size_t>(i) * cols_;
+    for (int j = 0; j < cols_; ++j) {
+      row[j] += expr(i, j);
+    }
+  }
+  return *this;
+}
+
+template <typename T>
+template <typename E, typename>
+S21MatrixT<T>& S21MatrixT<T>::operator-=(const E& expr) {
+  if (rows_ != expr.GetRows() || cols_ != expr.GetCols()) {
+    throw std::out_of_range(
+        "Incorrect input, matricex should have the same size");
+  }
+  if (expr.MayAlias({matrix_, rows_, cols_, cols_, 1})) {
+    return *this -= S21MatrixT(expr);
+  }
+  for (int i = 0; i < rows_; ++i) {
+    T* row = matrix_ + static_cast<std::size_t>(i) * cols_;
+    for (int j = 0; j < cols_; ++j) {
+      row[j] -= expr(i, j);
+    }
+  }
+  return *this;
+}
+
+template <typename L, typename R,
+          typename = std::enable_if_t<s21::IsLazyPair<L, R>::value>>
+s21::MatrixBinaryExpr<std::plus<s21::ValueOf<L>>, s21::OperandOfT<L>,
+                      s21::OperandOfT<R>>
+operator+(L&& lhs, R&& rhs) {
+  return {std::forward<L>(lhs), std::forward<R>(rhs)};
+}
+
+// Сумма с временной матрицей считается в её буфере
+template <typename L, typename R, typename = void,
+          typename = std::enable_if_t<s21::IsInPlacePair<L, R>::value>>
+s21::ExpiringOf<L, R> operator+(L&& lhs, R&& rhs) {
+  if constexpr (s21::IsExpiringMatrix<L>::value) {
+    lhs += rhs;
+    return std::move(lhs);
+  } else {
+    rhs += lhs;
+    return std::move(rhs);
+  }
+}
+
+template <typename L, typename R,
+          typename = std::enable_if_t<s21::IsLazyPair<L, R>::value>>
+s21::MatrixBinaryExpr<std::minus<s21::ValueOf<L>>, s21::OperandOfT<L>,
+                      s21::OperandOfT<R>>
+operator-(L&& lhs, R&& rhs) {
+  return {std::forward<L>(lhs), std::forward<R>(rhs)};
+}
+
+/**
+ * @brief Разность с временной матрицей в её буфере.
+ * @details Если временная только правая часть, в её буфер вычисляется
+ * lhs - rhs: каждый элемент читается до того, как перезаписывается.
+ */
+template <typename L, typename R, typename = void,
+          typename = std::enable_if_t<s21::IsInPlacePair<L, R>::value>>
+s21::ExpiringOf<L, R> operator-(L&& lhs, R&& rhs) {
+  if constexpr (s21::IsExpiringMatrix<L>::value) {
+    lhs -= rhs;
+    return std::move(lhs);
+  } else {
+    using T = s21::ValueOf<R>;
+    rhs = s21::MatrixBinaryExpr<std::minus<T>, s21::OperandOfT<L>,
+                                s21::MatrixLeaf<T>>(std::forward<L>(lhs), rhs);
+    return std::move(rhs);
+  }
+}
+
+template <typename L, typename = std::enable_if_t<
+                          s21::IsMatrixOperand<L>::value &&
+                          !s21::IsExpiringMatrix<L>::value>>
+s21::MatrixScaleExpr<s21::OperandOfT<L>> operator*(
+    L&& lhs, const s21::ValueOf<L> num) {
+  return {std::forward<L>(lhs), num};
+}
+
+// Тип числа не выводится, поэтому A * 2 тоже компилируется
+template <typename T>
+S21MatrixT<T> operator*(S21MatrixT<T>&& lhs, const std::common_type_t<T> num) {
+  lhs.MulNumber(num);
+  return std::move(lhs);
+}
+
+/**
+ * @brief Произведение матриц - считается сразу.
+ * @details Выделяется только буфер результата: готовые матрицы
+ * используются без копий, выражения вычисляются во временные.
+ */
+template <typename L, typename R,
+          typename = std::enable_if_t<s21::IsMatrixOperand<L>::value &&
+                                      s21::IsMatrixOperand<R>::value>>
+S21MatrixT<s21::ValueOf<L>> operator*(L&& lhs, R&& rhs) {
+  using View = S21MatrixViewT<const s21::ValueOf<L>>;
+  return s21::Multiply(View(s21::Materialize(lhs)),
+                       View(s21::Materialize(rhs)));
+}
+
+// Сравнение, в котором хотя бы одна сторона - ленивое выражение
+template <typename L, typename R,
+          typename = std::enable_if_t<
+              s21::IsMatrixOperand<L>::value &&
+              s21::IsMatrixOperand<R>::value &&
+              (s21::IsExprNode<L>::value || s21::IsExprNode<R>::value)>>
+bool operator==(const L& lhs, const R& rhs) {
+  return s21::Materialize(lhs).EqMatrix(s21::Materialize(rhs));
+}
+
+#endif  //__S21MATRIXEXPR_H__
@@ -0,0 +1,338 @@
+#include "s21_matrix_io.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace {
+// Данные пишутся и читаются блоками по 16 МБ
+constexpr std::size_t kChunkBytes = std::size_t(1) << 24;
+constexpr std::uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+constexpr std::uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+
+inline std::uint64_t Mix(std::uint64_t hash, std::uint64_t word) noexcept {
+  hash ^= word * kPrime1;
+  hash = (hash << 31) | (hash >> 33);
+  return hash * kPrime2;
+}
+
+inline std::uint64_t LoadWord(const unsigned char* bytes) noexcept {
+  std::uint64_t word;
+  std::memcpy(&word, bytes, sizeof(word));
+  return word;
+}
+
+// Размер данных в байтах: rows строк по stride элементов
+std::size_t DataBytes(const s21::MatrixFileHeader& header) noexcept {
+  return static_cast<std::size_t>(header.rows) *
+         static_cast<std::size_t>(header.stride) * header.element_size;
+}
+
+template <typename T>
+void CheckHeader(const s21::MatrixFileHeader& header) {
+  if (std::memcmp(header.magic, s21::kMatrixFileMagic,
+                  sizeof(header.magic)) != 0 ||
+      header.version != s21::kMatrixFileVersion) {
+    throw std::invalid_argument("Incorrect input, file is not a matrix");
+  }
+  if (header.byte_order != s21::kByteOrderMark) {
+    throw std::invalid_argument(
+        "Incorrect input, matrix file has another byte order");
+  }
+  if (header.dtype != s21::MatrixFileType<T>::kCode ||
+      header.element_size != sizeof(T)) {
+    throw std::invalid_argument(
+        "Incorrect input, matrix file has another element type");
+  }
+  if (header.rows < 0 || header.cols < 0 || header.rows > INT_MAX ||
+      header.stride > INT_MAX || header.stride < header.cols ||
+      header.data_offset < sizeof(s21::MatrixFileHeader) ||
+      header.data_offset % s21::kMatrixAlignment != 0) {
+    throw std::runtime_error("Matrix file is corrupted");
+  }
+  // Размер данных с отступом не должен переполняться: иначе проверка длины
+  // файла пропустит заголовок, а чтение уйдёт за конец данных. Предел -
+  // std::streamsize, чтобы Load мог пропустить data_offset байт
+  constexpr std::uint64_t kLimit = std::numeric_limits<std::streamsize>::max();
+  if (header.data_offset > kLimit ||
+      (header.stride > 0 &&
+       static_cast<std::uint64_t>(header.rows) >
+           (kLimit - header.data_offset) / sizeof(T) /
+               static_cast<std::uint64_t>(header.stride))) {
+    throw std::runtime_error("Matrix file is corrupted");
+  }
+}
+
+s21::MatrixFileHeader ReadHeader(std::istream& in) {
+  s21::MatrixFileHeader header;
+  if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+    throw std::runtime_error("Matrix file is truncated");
+  }
+  return header;
+}
+
+void ReadBytes(std::istream& in, char* dst, std::size_t bytes) {
+  while (bytes > 0) {
+    const std::size_t chunk = std::min(bytes, kChunkBytes);
+    if (!in.read(dst, static_cast<std::streamsize>(chunk))) {
+      throw std::runtime_error("Matrix file is truncated");
+    }
+    dst += chunk;
+    bytes -= chunk;
+  }
+}
+}  // namespace
+
+namespace s21 {
+std::uint64_t Checksum(const void* data, std::size_t bytes) noexcept {
+  const unsigned char* p = static_cast<const unsigned char*>(data);
+  std::uint64_t lanes[4] = {kPrime1, kPrime2, ~kPrime1, ~kPrime2};
+  std::size_t i = 0;
+  for (; i + 32 <= bytes; i += 32) {
+    for (int lane = 0; lane < 4; ++lane) {
+      lanes[lane] = Mix(lanes[lane], LoadWord(p + i + 8 * lane));
+    }
+  }
+  for (; i + 8 <= bytes; i += 8) {
+    lanes[0] = Mix(lanes[0], LoadWord(p + i));
+  }
+  std::uint64_t tail = 0;
+  for (std::size_t shift = 0; i < bytes; ++i, shift += 8) {
+    tail |= static_cast<std::uint64_t>(p[i]) << shift;
+  }
+  std::uint64_t hash = Mix(bytes, tail);
+  for (std::uint64_t lane : lanes) {
+    hash = Mix(hash, lane);
+  }
+  hash ^= hash >> 29;
+  hash *= kPrime1;
+  return hash ^ (hash >> 32);
+}
+
+template <typename T>
+void Save(const S21MatrixT<T>& matrix, std::ostream& out) {
+  MatrixFileHeader header{};
+  std::memcpy(header.magic, kMatrixFileMagic, sizeof(header.magic));
+  header.version = kMatrixFileVersion;
+  header.byte_order = kByteOrderMark;
+  header.dtype = s21::MatrixFileType<T>::kCode;
+  header.element_size = sizeof(T);
+  header.rows = matrix.GetRows();
+  header.cols = matrix.GetCols();
+  header.stride = matrix.GetStride();
+  header.data_offset = sizeof(MatrixFileHeader);
+  const std::size_t bytes = DataBytes(header);
+  const char* data = reinterpret_cast<const char*>(matrix.Data());
+  header.checksum = Checksum(data, bytes);
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  for (std::size_t done = 0; out && done < bytes; done += kChunkBytes) {
+    out.write(data + done, static_cast<std::streamsize>(
+                               std::min(kChunkBytes, bytes - done)));
+  }
+  if (!out) {
+    throw std::runtime_error("Cannot write matrix file");
+  }
+}
+
+template <typename T>
+void Save(const S21MatrixT<T>& matrix, const std::string& path) {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    throw std::runtime_error("Cannot open matrix file " + path);
+  }
+  Save(matrix, out);
+  out.close();
+  if (!out) {
+    throw std::runtime_error("Cannot write matrix file " + path);
+  }
+}
+
+template <typename T>
+S21MatrixT<T> Load(std::istream& in) {
+  const MatrixFileHeader header = ReadHeader(in);
+  CheckHeader<T>(header);
+  if (!in.ignore(static_cast<std::streamsize>(header.data_offset -
+                                              sizeof(header)))) {
+    throw std::runtime_error("Matrix file is truncated");
+  }
+  const int rows = static_cast<int>(header.rows);
+  const int cols = static_cast<int>(header.cols);
+  const std::size_t bytes = DataBytes(header);
+  S21MatrixT<T> res(rows, cols);
+  std::uint64_t checksum = 0;
+  if (header.stride == header.cols) {
+    ReadBytes(in, reinterpret_cast<char*>(res.Data()), bytes);
+    checksum = Checksum(res.Data(), bytes);
+  } else {
+    // Строки с запасом: данные читаются целиком и сжимаются до cols
+    std::vector<T> padded(bytes / sizeof(T));
+    ReadBytes(in, reinterpret_cast<char*>(padded.data()), bytes);
+    checksum = Checksum(padded.data(), bytes);
+    for (int i = 0; i < rows; ++i) {
+      std::copy_n(padded.data() + static_cast<std::size_t>(i) * header.stride,
+                  cols, res.Data() + static_cast<std::size_t>(i) * cols);
+    }
+  }
+  if (checksum != header.checksum) {
+    throw std::runtime_error("Matrix file checksum mismatch");
+  }
+  return res;
+}
+
+template <typename T>
+S21MatrixT<T> Load(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    throw std::runtime_error("Cannot open matrix file " + path);
+  }
+  return Load<T>(in);
+}
+
+#define S21_IO_INSTANTIATE(T)                                              \
+  template void Save(const S21MatrixT<T>& matrix, std::ostream& out);      \
+  template void Save(const S21MatrixT<T>& matrix, const std::string& path); \
+  template S21MatrixT<T> Load(std::istream& in);                           \
+  template S21MatrixT<T> Load(const std::string& path);
+
+S21_IO_INSTANTIATE(float)
+S21_IO_INSTANTIATE(double)
+S21_IO_INSTANTIATE(long double)
+S21_IO_INSTANTIATE(std::int64_t)
+#undef S21_IO_INSTANTIATE
+}  // namespace s21
+
+template <typename T>
+S21MappedMatrixT<T>::S21MappedMatrixT() noexcept
+    : mapping_(nullptr),
+      mapping_size_(0),
+      data_(nullptr),
+      rows_(0),
+      cols_(0),
+      stride_(0),
+      checksum_(0) {}
+
+/**
+ * @brief Отображение файла path.
+ * @details Дескриптор закрывается сразу после mmap - отображение живёт
+ * без него. Ошибки open, fstat и mmap - std::system_error с errno.
+ * @param verify сверить данные с контрольной суммой (читает весь файл)
+ */
+template <typename T>
+S21MappedMatrixT<T>::S21MappedMatrixT(const std::string& path, bool verify)
+    : S21MappedMatrixT() {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::system_error(errno, std::generic_category(),
+                            "Cannot open matrix file " + path);
+  }
+  struct stat info;
+  if (::fstat(fd, &info) != 0) {
+    const int error = errno;
+    ::close(fd);
+    throw std::system_error(error, std::generic_category(),
+                            "Cannot stat matrix file " + path);
+  }
+  mapping_size_ = static_cast<std::size_t>(info.st_size);
+  if (mapping_size_ < sizeof(s21::MatrixFileHeader)) {
+    ::close(fd);
+    throw std::runtime_error("Matrix file is truncated");
+  }
+  mapping_ = ::mmap(nullptr, mapping_size_, PROT_READ, MAP_SHARED, fd, 0);
+  const int error = errno;
+  ::close(fd);
+  if (mapping_ == MAP_FAILED) {
+    mapping_ = nullptr;
+    throw std::system_error(error, std::generic_category(),
+                            "Cannot map matrix file " + path);
+  }
+  try {
+    s21::MatrixFileHeader header;
+    std::memcpy(&header, mapping_, sizeof(header));
+    CheckHeader<T>(header);
+    if (header.data_offset + DataBytes(header) > mapping_size_) {
+      throw std::runtime_error("Matrix file is truncated");
+    }
+    data_ = reinterpret_cast<const T*>(static_cast<const char*>(mapping_) +
+                                       header.data_offset);
+    rows_ = static_cast<int>(header.rows);
+    cols_ = static_cast<int>(header.cols);
+    stride_ = static_cast<int>(header.stride);
+    checksum_ = header.checksum;
+    if (verify && !Verify()) {
+      throw std::runtime_error("Matrix file checksum mismatch");
+    }
+  } catch (...) {
+    Unmap();
+    throw;
+  }
+}
+
+template <typename T>
+S21MappedMatrixT<T>::S21MappedMatrixT(S21MappedMatrixT&& other) noexcept
+    : S21MappedMatrixT() {
+  *this = std::move(other);
+}
+
+template <typename T>
+S21MappedMatrixT<T>& S21MappedMatrixT<T>::operator=(
+    S21MappedMatrixT&& other) noexcept {
+  if (this != &other) {
+    Unmap();
+    mapping_ = std::exchange(other.mapping_, nullptr);
+    mapping_size_ = std::exchange(other.mapping_size_, 0);
+    data_ = std::exchange(other.data_, nullptr);
+    rows_ = std::exchange(other.rows_, 0);
+    cols_ = std::exchange(other.cols_, 0);
+    stride_ = std::exchange(other.stride_, 0);
+    checksum_ = std::exchange(other.checksum_, 0);
+  }
+  return *this;
+}
+
+template <typename T>
+S21MappedMatrixT<T>::~S21MappedMatrixT() {
+  Unmap();
+}
+
+template <typename T>
+void S21MappedMatrixT<T>::Unmap() noexcept {
+  if (mapping_ != nullptr) {
+    ::munmap(mapping_, mapping_size_);
+  }
+  mapping_ = nullptr;
+  mapping_size_ = 0;
+  data_ = nullptr;
+}
+
+template <typename T>
+bool S21MappedMatrixT<T>::Verify() const noexcept {
+  return s21::Checksum(data_, static_cast<std::size_t>(rows_) * stride_ *
+                                  sizeof(T)) == checksum_;
+}
+
+template <typename T>
+S21MatrixT<T> S21MappedMatrixT<T>::ToMatrix() const {
+  S21MatrixT<T> res(rows_, cols_);
+  for (int i = 0; i < rows_; ++i) {
+    std::copy_n(data_ + static_cast<std::size_t>(i) * stride_, cols_,
+                res.Data() + static_cast<std::size_t>(i) * cols_);
+  }
+  return res;
+}
+
+template class S21MappedMatrixT<float>;
+template class S21MappedMatrixT<double>;
+template class S21MappedMatrixT<long double>;
+template class S21MappedMatrixT<std::int64_t>;
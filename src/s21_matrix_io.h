@@ -0,0 +1,147 @@
+#ifndef __S21MATRIXIO_H__
+#define __S21MATRIXIO_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include "s21_matrix_oop.h"
+
+namespace s21 {
+/**
+ * @brief Заголовок файла матрицы (64 байта, порядок байт - хоста).
+ * @details
+ * Файл - заголовок и за ним данные со смещения data_offset, кратного
+ * kMatrixAlignment: отображённая в память матрица выровнена так же, как
+ * буфер S21Matrix. Строки идут через stride элементов (stride >= cols).
+ * checksum - s21::Checksum байт данных, byte_order - kByteOrderMark в
+ * порядке байт записавшей машины, по нему отличается файл с другим
+ * порядком байт.
+ */
+struct MatrixFileHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t byte_order;
+  // Код типа элементов: 1 - float, 2 - double, 3 - long double, 4 - int64
+  std::uint32_t dtype;
+  std::uint32_t element_size;
+  std::int64_t rows, cols, stride;
+  std::uint64_t data_offset;
+  std::uint64_t checksum;
+};
+static_assert(sizeof(MatrixFileHeader) == 64, "Header must be 64 bytes");
+
+constexpr char kMatrixFileMagic[8] = {'S', '2', '1', 'M', 'A', 'T', 'R', 'X'};
+constexpr std::uint32_t kMatrixFileVersion = 1;
+constexpr std::uint32_t kByteOrderMark = 0x01020304;
+
+// Код типа элементов для поля dtype заголовка
+template <typename T>
+struct MatrixFileType;
+template <>
+struct MatrixFileType<float> {
+  static constexpr std::uint32_t kCode = 1;
+};
+template <>
+struct MatrixFileType<double> {
+  static constexpr std::uint32_t kCode = 2;
+};
+template <>
+struct MatrixFileType<long double> {
+  static constexpr std::uint32_t kCode = 3;
+};
+template <>
+struct MatrixFileType<std::int64_t> {
+  static constexpr std::uint32_t kCode = 4;
+};
+
+/**
+ * @brief 64-битная контрольная сумма буфера.
+ * @details Четыре независимые цепочки перемешивания по 8-байтовым словам
+ * не ждут друг друга, так что сумма считается со скоростью чтения
+ * памяти, а не по байту за такт. Хвост, не кратный 32 байтам, - по
+ * словам и байтам.
+ */
+std::uint64_t Checksum(const void* data, std::size_t bytes) noexcept;
+
+/**
+ * @brief Запись матрицы в двоичном формате.
+ * @details Данные пишутся из буфера матрицы крупными блоками, без
+ * поэлементного вывода и промежуточных копий. Ошибка записи -
+ * std::runtime_error.
+ */
+template <typename T>
+void Save(const S21MatrixT<T>& matrix, std::ostream& out);
+template <typename T>
+void Save(const S21MatrixT<T>& matrix, const std::string& path);
+
+/**
+ * @brief Чтение матрицы, записанной Save.
+ * @details Данные читаются сразу в буфер результата и сверяются с
+ * контрольной суммой. Чужой файл, другой тип элементов или порядок
+ * байт - std::invalid_argument, обрезанный или повреждённый файл -
+ * std::runtime_error.
+ */
+template <typename T>
+S21MatrixT<T> Load(std::istream& in);
+template <typename T>
+S21MatrixT<T> Load(const std::string& path);
+}  // namespace s21
+
+/**
+ * @brief Матрица только для чтения прямо из отображённого в память файла.
+ * @details
+ * Файл формата s21::Save отображается mmap, элементы читаются со страниц
+ * файла без копирования: открытие матрицы любого размера - проверка
+ * заголовка, а страницы подгружаются системой при первом обращении и
+ * разделяются между процессами. Контрольная сумма требует чтения всех
+ * данных, поэтому проверяется только по Verify() или verify = true.
+ * View() - представление для выражений и произведений без копии.
+ */
+template <typename T>
+class S21MappedMatrixT final {
+ private:
+  void* mapping_;
+  std::size_t mapping_size_;
+  const T* data_;
+  int rows_, cols_, stride_;
+  std::uint64_t checksum_;
+
+  void Unmap() noexcept;
+
+ public:
+  S21MappedMatrixT() noexcept;
+  explicit S21MappedMatrixT(const std::string& path, bool verify = false);
+  S21MappedMatrixT(const S21MappedMatrixT&) = delete;
+  S21MappedMatrixT(S21MappedMatrixT&& other) noexcept;
+  S21MappedMatrixT& operator=(const S21MappedMatrixT&) = delete;
+  S21MappedMatrixT& operator=(S21MappedMatrixT&& other) noexcept;
+  ~S21MappedMatrixT();
+
+  // Сверка данных с контрольной суммой заголовка
+  bool Verify() const noexcept;
+  // Копия в обычную матрицу
+  S21MatrixT<T> ToMatrix() const;
+
+  T operator()(int row, int col) const noexcept {
+    return data_[static_cast<std::size_t>(row) * stride_ + col];
+  }
+  int GetRows() const noexcept { return rows_; }
+  int GetCols() const noexcept { return cols_; }
+  int GetStride() const noexcept { return stride_; }
+  const T* Data() const noexcept { return data_; }
+
+  S21MatrixViewT<const T> View() const {
+    return {data_, rows_, cols_, stride_};
+  }
+};
+
+using S21MappedMatrix = S21MappedMatrixT<double>;
+
+extern template class S21MappedMatrixT<float>;
+extern template class S21MappedMatrixT<double>;
+extern template class S21MappedMatrixT<long double>;
+extern template class S21MappedMatrixT<std::int64_t>;
+
+#endif  //__S21MATRIXIO_H__
@@ -1,12 +1,333 @@
 #include "s21_matrix_oop.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "s21_cholesky.h"
+#include "s21_gemm.h"
+#include "s21_lu.h"
+#include "s21_simd.h"
+#include "s21_strassen.h"
+#include "s21_transpose.h"
+
+namespace {
+/**
+ * @brief Алгебраические дополнения вырожденной матрицы.
+ * @details
+ * Строится разложение P * A * Q = L * U с полным выбором главного элемента.
+ * Если какой-то из первых n - 1 ведущих элементов не больше
+ * kPivotEpsilon * max|a_ij|, ранг меньше n - 1 и результат нулевой: порог
+ * относительный, поэтому ответ не меняется при умножении матрицы на
+ * число. Иначе, обозначив
+ * U = [U11 u12; 0 u_nn] и d = det(U11),
+ *   adj(U) = d * [u_nn * U11^-1, -U11^-1 * u12; 0, 1]
+ * (формула верна и при u_nn = 0), adj(L * U) = adj(U) * L^-1, а перестановки
+ * возвращаются с учётом их знака. Всё считается за O(n^3).
+ */
+template <typename T>
+S21MatrixT<T> SingularComplements(const S21MatrixT<T>& matrix) {
+  const int n = matrix.GetRows();
+  S21MatrixT<T> work(matrix);
+  T* w = work.Data();
+  std::vector<int> row_perm(n);
+  std::vector<int> col_perm(n);
+  for (int i = 0; i < n; ++i) {
+    row_perm[i] = i;
+    col_perm[i] = i;
+  }
+  T scale = T(0);
+  for (int i = 0; i < n * n; ++i) {
+    scale = std::max(scale, T(std::abs(w[i])));
+  }
+  const T threshold = s21::ScalarTraits<T>::kPivotEpsilon * scale;
+  T sign = T(1);
+  S21MatrixT<T> res(n, n);
+  for (int i = 0; i < n - 1; ++i) {
+    int pivot_row = i;
+    int pivot_col = i;
+    for (int r = i; r < n; ++r) {
+      for (int c = i; c < n; ++c) {
+        if (std::abs(w[r * n + c]) > std::abs(w[pivot_row * n + pivot_col])) {
+          pivot_row = r;
+          pivot_col = c;
+        }
+      }
+    }
+    if (std::abs(w[pivot_row * n + pivot_col]) <= threshold) {
+      return res;
+    }
+    if (pivot_row != i) {
+      std::swap_ranges(w + i * n, w + (i + 1) * n, w + pivot_row * n);
+      std::swap(row_perm[i], row_perm[pivot_row]);
+      sign = -sign;
+    }
+    if (pivot_col != i) {
+      for (int r = 0; r < n; ++r) {
+        std::swap(w[r * n + i], w[r * n + pivot_col]);
+      }
+      std::swap(col_perm[i], col_perm[pivot_col]);
+      sign = -sign;
+    }
+    const T* pivot = w + i * n;
+    for (int r = i + 1; r < n; ++r) {
+      T* row = w + r * n;
+      T coeff = row[i] / pivot[i];
+      row[i] = coeff;
+      for (int c = i + 1; c < n; ++c) {
+        row[c] -= pivot[c] * coeff;
+      }
+    }
+  }
+  const int m = n - 1;
+  T d = T(1);
+  for (int i = 0; i < m; ++i) {
+    d *= w[i * n + i];
+  }
+  // adj(U): обратная к U11 считается обратным ходом по столбцам единичной
+  S21MatrixT<T> adj_u(n, n);
+  T* au = adj_u.Data();
+  const T u_nn = w[m * n + m];
+  for (int j = 0; j <= m; ++j) {
+    // столбец j < m: d * u_nn * U11^-1 * e_j, столбец m: -d * U11^-1 * u12
+    for (int i = m - 1; i >= 0; --i) {
+      T sum = j < m ? (i == j ? d * u_nn : T(0)) : -d * w[i * n + m];
+      for (int k = i + 1; k < m; ++k) {
+        sum -= w[i * n + k] * au[k * n + j];
+      }
+      au[i * n + j] = sum / w[i * n + i];
+    }
+  }
+  au[m * n + m] = d;
+  // L^-1 (нижняя унитреугольная) прямым ходом
+  S21MatrixT<T> l_inv(n, n);
+  T* li = l_inv.Data();
+  for (int i = 0; i < n; ++i) {
+    li[i * n + i] = T(1);
+    for (int j = 0; j < i; ++j) {
+      T sum = T(0);
+      for (int k = j; k < i; ++k) {
+        sum -= w[i * n + k] * li[k * n + j];
+      }
+      li[i * n + j] = sum;
+    }
+  }
+  S21MatrixT<T> adj_lu = adj_u * l_inv;
+  // adj(A) = sign * Q * adj(LU) * P, дополнения - транспонированная adj(A)
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      res(row_perm[i], col_perm[j]) = sign * adj_lu(j, i);
+    }
+  }
+  return res;
+}
+// Произведения в целых матрицах считаются в 128 битах: промежуточные
+// значения метода Барейса сами укладываются в 64 бита, а их произведения
+// - нет
+using Wide = __int128;
+
+/**
+ * @brief Определитель целой матрицы методом Барейса.
+ * @details Исключение Гаусса без дробей: после шага k каждый элемент
+ * остатка - минор порядка k + 1 исходной матрицы, поэтому деление на
+ * предыдущий ведущий элемент всегда нацело и результат точен.
+ * @param m матрица [n x n] построчно, портится
+ */
+template <typename T>
+T BareissDeterminant(T* m, int n) {
+  T sign = 1;
+  T prev = 1;
+  for (int k = 0; k < n - 1; ++k) {
+    if (m[k * n + k] == 0) {
+      int pivot = k + 1;
+      while (pivot < n && m[pivot * n + k] == 0) {
+        ++pivot;
+      }
+      if (pivot == n) {
+        return 0;
+      }
+      std::swap_ranges(m + k * n, m + (k + 1) * n, m + pivot * n);
+      sign = -sign;
+    }
+    for (int i = k + 1; i < n; ++i) {
+      for (int j = k + 1; j < n; ++j) {
+        m[i * n + j] = static_cast<T>(
+            (Wide(m[i * n + j]) * m[k * n + k] -
+             Wide(m[i * n + k]) * m[k * n + j]) /
+            prev);
+      }
+    }
+    prev = m[k * n + k];
+  }
+  return sign * m[n * n - 1];
+}
+
+/**
+ * @brief Присоединённая матрица adj(A) = det(A) * A^-1 целой матрицы.
+ * @details Метод Барейса в варианте Гаусса-Жордана над [A | E]: после
+ * последнего шага слева стоит d * E, справа - d * A^-1, где d - определитель
+ * с учётом перестановок строк. Все деления нацело. Для вырожденной матрицы
+ * adj(A) собирается из миноров, каждый - тем же методом Барейса.
+ * @param det сюда записывается определитель
+ */
+template <typename T>
+S21MatrixT<T> IntegerAdjugate(const S21MatrixT<T>& matrix, T& det) {
+  const int n = matrix.GetRows();
+  const int width = 2 * n;
+  std::vector<T> w(static_cast<std::size_t>(n) * width, 0);
+  for (int i = 0; i < n; ++i) {
+    std::copy_n(matrix.Data() + i * n, n, w.begin() + i * width);
+    w[i * width + n + i] = 1;
+  }
+  T sign = 1;
+  T prev = 1;
+  bool singular = false;
+  for (int k = 0; k < n && !singular; ++k) {
+    int pivot = k;
+    while (pivot < n && w[pivot * width + k] == 0) {
+      ++pivot;
+    }
+    if (pivot == n) {
+      singular = true;
+      continue;
+    }
+    if (pivot != k) {
+      std::swap_ranges(w.begin() + k * width, w.begin() + (k + 1) * width,
+                       w.begin() + pivot * width);
+      sign = -sign;
+    }
+    const T* pivot_row = w.data() + k * width;
+    for (int i = 0; i < n; ++i) {
+      if (i == k) {
+        continue;
+      }
+      T* row = w.data() + i * width;
+      for (int j = 0; j < width; ++j) {
+        if (j != k) {
+          row[j] = static_cast<T>(
+              (Wide(row[j]) * pivot_row[k] - Wide(row[k]) * pivot_row[j]) /
+              prev);
+        }
+      }
+      row[k] = 0;
+    }
+    prev = pivot_row[k];
+  }
+  S21MatrixT<T> res(n, n);
+  if (!singular) {
+    det = sign * prev;
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) {
+        res(i, j) = sign * w[i * width + n + j];
+      }
+    }
+  } else {
+    det = 0;
+    std::vector<T> minor(static_cast<std::size_t>(n - 1) * (n - 1));
+    for (int r = 0; r < n && n > 1; ++r) {
+      for (int c = 0; c < n; ++c) {
+        std::size_t pos = 0;
+        for (int i = 0; i < n; ++i) {
+          for (int j = 0; j < n; ++j) {
+            if (i != r && j != c) {
+              minor[pos++] = matrix(i, j);
+            }
+          }
+        }
+        const T value = BareissDeterminant(minor.data(), n - 1);
+        res(c, r) = (r + c) % 2 == 0 ? value : -value;
+      }
+    }
+  }
+  return res;
+}
+
+/**
+ * @brief Произведение [rows x inner] * [inner x cols] по шагам операндов.
+ * @details Большие матрицы умножаются блочным Gemm, который сам учитывает
+ * шаги операндов, или, если включено s21::SetStrassenCrossover, по схеме
+ * Штрассена-Винограда. Малые - циклом в порядке i-k-j, где при единичном шаге
+ * по столбцам все три матрицы читаются построчно. Выделяется только
+ * буфер результата, операнды не копируются.
+ */
+template <typename T>
+S21MatrixT<T> MultiplyStrided(int rows, int inner, int cols, const T* a,
+                              int a_row_stride, int a_col_stride, const T* b,
+                              int b_rows, int b_row_stride,
+                              int b_col_stride) {
+  if (inner != b_rows) {
+    throw std::invalid_argument(
+        "Incorrect input, matricex should have format M1.cols_ = M2.rows_");
+  }
+  if (a == nullptr || b == nullptr || rows < 1 || inner < 1 || cols < 1) {
+    throw std::out_of_range("Invalid matrix");
+  }
+  S21MatrixT<T> res(rows, cols);
+  T* res_data = res.Data();
+  // У целых промежуточные суммы Штрассена могут переполниться там, где
+  // обычное произведение точно, поэтому он только для вещественных
+  if constexpr (std::is_floating_point<T>::value) {
+    const int crossover = s21::GetStrassenCrossover();
+    if (crossover > 0 && a_col_stride == 1 && b_col_stride == 1 &&
+        std::min(std::min(rows, inner), cols) >= crossover) {
+      s21::StrassenGemm(rows, cols, inner, a, a_row_stride, b, b_row_stride,
+                        res_data, cols, crossover);
+      return res;
+    }
+  }
+  if (static_cast<std::int64_t>(rows) * inner * cols >= s21::kGemmThreshold) {
+    s21::Gemm(rows, cols, inner, T(1), a, a_row_stride, a_col_stride, b,
+              b_row_stride, b_col_stride, T(0), res_data, cols);
+  } else {
+    for (int i = 0; i < rows; i++) {
+      T* res_row = res_data + i * cols;
+      for (int k = 0; k < inner; k++) {
+        const T a_ik = a[static_cast<std::ptrdiff_t>(i) * a_row_stride +
+                         static_cast<std::ptrdiff_t>(k) * a_col_stride];
+        const T* b_row = b + static_cast<std::ptrdiff_t>(k) * b_row_stride;
+        if (b_col_stride == 1) {
+          for (int j = 0; j < cols; j++) {
+            res_row[j] += a_ik * b_row[j];
+          }
+        } else {
+          for (int j = 0; j < cols; j++) {
+            res_row[j] += a_ik * b_row[j * b_col_stride];
+          }
+        }
+      }
+    }
+  }
+  return res;
+}
+/**
+ * @brief Необходимые условия положительной определённости за O(n^2):
+ * точная симметрия и положительная диагональ.
+ * @details Такие матрицы сначала раскладываются по Холецкому, и только
+ * если разложение не удалось - через LU.
+ */
+template <typename T>
+bool MaybePositiveDefinite(const S21MatrixT<T>& matrix) {
+  const int n = matrix.GetRows();
+  bool res = true;
+  for (int i = 0; i < n && res; ++i) {
+    res = matrix(i, i) > T(0);
+    for (int j = 0; j < i && res; ++j) {
+      res = matrix(i, j) == matrix(j, i);
+    }
+  }
+  return res;
+}
+}  // namespace
+
 // Вспомогательные функции
 /**
  * @brief Валидация матриц this и other
  * @details Первичная проверка на валидность матриц для проведения операций
  * @param other одна из проверяемых матриц
  */
-bool S21Matrix::CheckMatrix(const S21Matrix& other) const noexcept {
+template <typename T>
+bool S21MatrixT<T>::CheckMatrix(const S21MatrixT& other) const noexcept {
   bool res = s21::PASSED;
   if (matrix_ == nullptr || other.matrix_ == nullptr) {
     res = s21::FAILED;
@@ -17,41 +338,49 @@ bool S21Matrix::CheckMatrix(const S21Matrix& other) const noexcept {
   return res;
 }
 
-void S21Matrix::FreeMatrix() {
-  for (int i = 0; i < this->rows_; i++) {
-    delete[] this->matrix_[i];
-  }
-  delete[] this->matrix_;
+template <typename T>
+void S21MatrixT<T>::FreeMatrix() {
+  s21::FreeBuffer(matrix_);
 }
 /**
  * @brief Вспомогательная функция. Алокация памяти.
  * @details
- *       try{..} catch(..) {..}
- * необходим для выброса ошибки при провальной инициализации памяти
- * std::bad_allock(), а так же чисткой памяти в такой ситуации.
+ * Матрица хранится одним выровненным блоком построчно (row-major):
+ * элемент [i][j] лежит по смещению i * GetStride() + j. Одна аллокация
+ * на матрицу вместо rows_ + 1, строки идут в памяти подряд.
+ * Память берётся через s21::AllocateBuffer - из арены, пула потока или
+ * кучи (см. s21_allocator.h). При нехватке памяти выбрасывается
+ * std::bad_alloc. Память не инициализируется - это делает вызывающий код,
+ * которому известно, чем заполнить буфер.
  */
-void S21Matrix::AllocateMatrix() {
-  matrix_ = new double*[rows_]();
-  for (int i = 0; i < rows_; i++) {
-    try {
-      matrix_[i] = new double[cols_];
-    } catch (...) {
-      for (int j = 0; j < i; ++j) {
-        delete[] matrix_[j];
-      }
-      delete[] matrix_;
-      throw std::bad_alloc();
-    }
-  }
-  FillWithZeroes();
+template <typename T>
+void S21MatrixT<T>::AllocateMatrix() {
+  capacity_ = static_cast<std::size_t>(rows_) * cols_;
+  matrix_ = s21::AllocateBuffer<T>(capacity_);
 }
 
-void S21Matrix::FillWithZeroes() noexcept {
+/**
+ * @brief Перенос данных в новый буфер на capacity элементов.
+ * @details Строки перекладываются с длины cols_ на длину cols: лишние
+ * столбцы отбрасываются, новые заполняются нулями.
+ */
+template <typename T>
+void S21MatrixT<T>::Reallocate(std::size_t capacity, int cols) {
+  T* buffer = s21::AllocateBuffer<T>(capacity);
+  const int common = std::min(cols, cols_);
   for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      matrix_[i][j] = 0;
-    }
+    T* dst = buffer + static_cast<std::size_t>(i) * cols;
+    std::copy_n(matrix_ + static_cast<std::size_t>(i) * cols_, common, dst);
+    std::fill(dst + common, dst + cols, T(0));
   }
+  FreeMatrix();
+  matrix_ = buffer;
+  capacity_ = capacity;
+}
+
+template <typename T>
+void S21MatrixT<T>::FillWithZeroes() noexcept {
+  s21::GetKernels<T>().zero(matrix_, static_cast<std::size_t>(rows_) * cols_);
 }
 
 // Конструкторы
@@ -66,7 +395,9 @@ void S21Matrix::FillWithZeroes() noexcept {
  * описанную выше, тем самым уменьшается размер генерируемого файла
  * и ускоряется работа самой программы.
  */
-S21Matrix::S21Matrix() noexcept : rows_(0), cols_(0), matrix_(nullptr) {}
+template <typename T>
+S21MatrixT<T>::S21MatrixT() noexcept
+    : rows_(0), cols_(0), matrix_(nullptr), capacity_(0) {}
 
 /**
  * @brief Конструктор параметизированный
@@ -77,11 +408,13 @@ S21Matrix::S21Matrix() noexcept : rows_(0), cols_(0), matrix_(nullptr) {}
  * @param cols количество столбцов
  *
  */
-S21Matrix::S21Matrix(int rows, int cols) : rows_(rows), cols_(cols) {
+template <typename T>
+S21MatrixT<T>::S21MatrixT(int rows, int cols) : rows_(rows), cols_(cols) {
   if (rows_ < 0 || cols_ < 0) {
     throw std::length_error("Matrix size must be greater than 0");
   }
   this->AllocateMatrix();
+  this->FillWithZeroes();
 }
 /**
  * @brief Конструктор копирования
@@ -90,12 +423,12 @@ S21Matrix::S21Matrix(int rows, int cols) : rows_(rows), cols_(cols) {
  * память и копируем с помощью memcpy.
  * @param other Матрица из которой копируем данные
  */
-S21Matrix::S21Matrix(const S21Matrix& other)
+template <typename T>
+S21MatrixT<T>::S21MatrixT(const S21MatrixT& other)
     : rows_(other.rows_), cols_(other.cols_) {
   this->AllocateMatrix();
-  for (int i = 0; i < rows_; i++) {
-    memcpy(matrix_[i], other.matrix_[i], other.cols_ * sizeof(double));
-  }
+  memcpy(matrix_, other.matrix_,
+         static_cast<std::size_t>(rows_) * cols_ * sizeof(T));
 }
 /**
  * @brief Конструктор переноса
@@ -103,336 +436,496 @@ S21Matrix::S21Matrix(const S21Matrix& other)
  * В MIL обновлаяем значения this из other и зануляем переменные объекта other
  * @param other
  */
-S21Matrix::S21Matrix(S21Matrix&& other) noexcept
-    : rows_(other.rows_), cols_(other.cols_), matrix_(other.matrix_) {
+template <typename T>
+S21MatrixT<T>::S21MatrixT(S21MatrixT&& other) noexcept
+    : rows_(other.rows_),
+      cols_(other.cols_),
+      matrix_(other.matrix_),
+      capacity_(other.capacity_) {
   other.matrix_ = nullptr;
   other.rows_ = 0;
   other.cols_ = 0;
+  other.capacity_ = 0;
 }
 
 // Базовые операции над матрицами
-bool S21Matrix::EqMatrix(const S21Matrix& other) const noexcept {
+/**
+ * @brief Сравнение с допуском s21::ScalarTraits<T>::kEpsilon.
+ * @details Для целых матриц допуск нулевой - сравнение точное.
+ */
+template <typename T>
+bool S21MatrixT<T>::EqMatrix(const S21MatrixT& other) const noexcept {
   int is_eq = s21::PASSED;
   if (rows_ != other.rows_ || cols_ != other.cols_) {
     is_eq = s21::FAILED;
   }
   if (is_eq == s21::PASSED) {
-    for (int i = 0; i < rows_ && is_eq == true; i++) {
-      for (int j = 0; j < cols_ && is_eq == true; j++) {
-        if (fabs(matrix_[i][j] - other.matrix_[i][j]) > 1e-7) {
-          is_eq = s21::FAILED;
-        }
-      }
-    }
+    std::size_t count = static_cast<std::size_t>(rows_) * cols_;
+    is_eq = s21::GetKernels<T>().equal(matrix_, other.matrix_, count,
+                                       s21::ScalarTraits<T>::kEpsilon);
   }
   return is_eq;
 }
 
-void S21Matrix::SumMatrix(const S21Matrix& other) {
+template <typename T>
+void S21MatrixT<T>::SumMatrix(const S21MatrixT& other) {
   if (rows_ != other.rows_ || cols_ != other.cols_) {
     throw std::out_of_range(
         "Incorrect input, matricex should have the same size");
   }
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      matrix_[i][j] = matrix_[i][j] + other.matrix_[i][j];
-    }
-  }
+  s21::GetKernels<T>().add(matrix_, other.matrix_,
+                           static_cast<std::size_t>(rows_) * cols_);
 }
 
-void S21Matrix::SubMatrix(const S21Matrix& other) {
+template <typename T>
+void S21MatrixT<T>::SubMatrix(const S21MatrixT& other) {
   if (rows_ != other.rows_ || cols_ != other.cols_) {
     throw std::out_of_range(
         "Incorrect input, matricex should have the same size");
   }
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      matrix_[i][j] = matrix_[i][j] - other.matrix_[i][j];
-    }
-  }
+  s21::GetKernels<T>().sub(matrix_, other.matrix_,
+                           static_cast<std::size_t>(rows_) * cols_);
 }
 
-void S21Matrix::MulNumber(const double num) {
+template <typename T>
+void S21MatrixT<T>::MulNumber(const T num) {
   if (matrix_ == nullptr) {
     throw std::bad_weak_ptr();
   }
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      matrix_[i][j] = matrix_[i][j] * num;
-    }
-  }
+  s21::GetKernels<T>().scale(matrix_, num,
+                             static_cast<std::size_t>(rows_) * cols_);
 }
 
-void S21Matrix::MulMatrix(const S21Matrix& other) {
-  bool matrix_status = this->CheckMatrix(other);
-  if (cols_ != other.rows_) {
-    throw std::invalid_argument(
-        "Incorrect input, matricex should have format M1.cols_ = M2.rows_");
-  } else if (matrix_status == s21::PASSED) {
-    S21Matrix new_matrix(rows_, other.GetCols());
-    for (int i = 0; i < rows_; i++) {
-      for (int j = 0; j < other.cols_; j++) {
-        new_matrix.matrix_[i][j] = 0;
-        for (int k = 0; k < other.rows_; k++) {
-          new_matrix.matrix_[i][j] += matrix_[i][k] * other.matrix_[k][j];
-        }
-      }
-    }
-    *this = new_matrix;
-  } else {
-    throw std::out_of_range("Invalid matrix");
-  }
+/**
+ * @brief Умножение на месте.
+ * @details Результат считается в новый буфер, который затем перемещается
+ * в this - старый буфер освобождается, копии результата нет.
+ */
+template <typename T>
+void S21MatrixT<T>::MulMatrix(const S21MatrixT& other) {
+  *this = s21::Multiply(*this, other);
 }
 
-S21Matrix S21Matrix::Transpose() {
-  S21Matrix res(cols_, rows_);
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      res.matrix_[j][i] = matrix_[i][j];
-    }
-  }
+/**
+ * @brief Транспонированная матрица.
+ * @details Блочная рекурсия с регистровыми блоками (s21::Transpose)
+ * вместо записи по столбцам результата на каждом элементе.
+ */
+template <typename T>
+S21MatrixT<T> S21MatrixT<T>::Transpose() const {
+  S21MatrixT res;
+  res.rows_ = cols_;
+  res.cols_ = rows_;
+  res.AllocateMatrix();
+  s21::Transpose(matrix_, rows_, cols_, cols_, res.matrix_, rows_);
   return res;
 }
 
-double S21Matrix::Determinant() {
+/**
+ * @brief Транспонирование без второго буфера.
+ * @details Квадратная матрица обрабатывается блоками на месте,
+ * прямоугольная - обходом циклов перестановки (медленнее, зато без
+ * аллокации второй матрицы).
+ */
+template <typename T>
+void S21MatrixT<T>::TransposeInPlace() {
+  s21::TransposeInPlace(matrix_, rows_, cols_);
+  std::swap(rows_, cols_);
+}
+
+/**
+ * @brief Определитель через LU-разложение.
+ * @details Для многократной работы с одной матрицей (определитель, обратная,
+ * решение систем) выгоднее один раз построить S21LU и обращаться к нему.
+ * Симметричная матрица с положительной диагональю сначала раскладывается
+ * вдвое дешевле по Холецкому. Определитель целой матрицы считается точно
+ * методом Барейса.
+ */
+template <typename T>
+T S21MatrixT<T>::Determinant() const {
   if (rows_ != cols_) {
     throw std::invalid_argument("Matrix should have square format.");
   }
-  double res = 1.0;
-  S21Matrix temp_m{*this};
-  int size = rows_;
-  for (int i = 0; i < size; ++i) {
-    int plot_ind = i;
-    for (int j = i + 1; j < size; ++j) {
-      if (std::abs(temp_m(j, i)) > std::abs(temp_m(plot_ind, i))) {
-        plot_ind = j;
-      }
-    }
-    if (std::abs(temp_m(plot_ind, i)) < 1e-7) {
-      return 0.0;
-    }
-    temp_m.SwapRows(i, plot_ind);
-    res *= temp_m(i, i);
-    if (i != plot_ind) {
-      res = -res;
-    }
-    for (int j = i + 1; j < size; ++j) {
-      double coeff = temp_m(j, i) / temp_m(i, i);
-      for (int k = i; k < size; ++k) {
-        temp_m(j, k) -= temp_m(i, k) * coeff;
-      }
+  T res = T(1);
+  if (rows_ > 0) {
+    if constexpr (std::is_integral<T>::value) {
+      S21MatrixT work(*this);
+      res = BareissDeterminant(work.matrix_, rows_);
+    } else if (!MaybePositiveDefinite(*this)) {
+      res = S21LUT<T>(*this).Determinant();
+    } else {
+      S21CholeskyT<T> cholesky(*this);
+      res = cholesky.IsPositiveDefinite() ? cholesky.Determinant()
+                                          : S21LUT<T>(*this).Determinant();
     }
   }
   return res;
 }
 
-S21Matrix S21Matrix::CalcMinorMat(int i_ignore, int j_ignore) {
-  S21Matrix res(rows_ - 1, cols_ - 1);
-  int shift_row = 0;
-  for (int i = 0; i < res.rows_; ++i) {
-    if (i == i_ignore) {
-      shift_row = 1;
-    }
-    int shift_col = 0;
-    for (int j = 0; j < res.cols_; ++j) {
-      if (j == j_ignore) {
-        shift_col = 1;
+/**
+ * @brief Знак и ln|det A| за одно LU-разложение.
+ * @details В отличие от Determinant не переполняется и не уходит в ноль
+ * при любом размере матрицы. Положительно определённая матрица, как и в
+ * Determinant, раскладывается по Холецкому. Для вырожденной матрицы знак
+ * 0, а логарифм - минус бесконечность. Для целой матрицы логарифм берётся
+ * от точного определителя Барейса.
+ */
+template <typename T>
+s21::LogDeterminant<typename s21::ScalarTraits<T>::Real>
+S21MatrixT<T>::LogAbsDeterminant() const {
+  using Real = typename s21::ScalarTraits<T>::Real;
+  if (rows_ != cols_) {
+    throw std::invalid_argument("Matrix should have square format.");
+  }
+  s21::LogDeterminant<Real> res{1, Real(0)};
+  if (rows_ > 0) {
+    if constexpr (std::is_integral<T>::value) {
+      const T det = Determinant();
+      res.sign = (det > 0) - (det < 0);
+      res.log_abs = det != 0 ? std::log(std::abs(static_cast<Real>(det)))
+                             : -std::numeric_limits<Real>::infinity();
+    } else {
+      if (MaybePositiveDefinite(*this)) {
+        S21CholeskyT<T> cholesky(*this);
+        if (cholesky.IsPositiveDefinite()) {
+          res.log_abs = cholesky.LogAbsDeterminant();
+          return res;
+        }
       }
-      res(i, j) = (*this)(i + shift_row, j + shift_col);
+      S21LUT<T> lu(*this);
+      res.sign = lu.GetSign();
+      res.log_abs = lu.LogAbsDeterminant();
     }
   }
   return res;
 }
 
-S21Matrix S21Matrix::CalcComplements() {
+/**
+ * @brief Матрица алгебраических дополнений за O(n^3).
+ * @details
+ * Для невырожденной матрицы C = det(A) * (A^-1)^T по одному LU-разложению.
+ * Для вырожденной (или вырожденной с точностью до машинного эпсилон по
+ * ReciprocalCondition) - разложение с полным выбором главного элемента
+ * (SingularComplements): при rank(A) < n - 1 все миноры порядка n - 1
+ * нулевые, при rank(A) = n - 1 дополнения выражаются через то же
+ * разложение без вычисления отдельных миноров. Для целой матрицы
+ * C = adj(A)^T считается точно (IntegerAdjugate).
+ */
+template <typename T>
+S21MatrixT<T> S21MatrixT<T>::CalcComplements() const {
   if (rows_ != cols_) {
     throw std::invalid_argument("Matrix should have square format.");
   }
-  S21Matrix res(rows_, cols_);
-  for (int i = 0; i < res.rows_; i++) {
-    for (int j = 0; j < res.cols_; j++) {
-      S21Matrix minor_matrix = CalcMinorMat(i, j);
-      res(i, j) = minor_matrix.Determinant();
-
-      if ((i + j) % 2 != 0) {
-        res(i, j) = -res(i, j);
+  S21MatrixT res(rows_, cols_);
+  if (rows_ > 0) {
+    if constexpr (std::is_integral<T>::value) {
+      T det = 0;
+      res = IntegerAdjugate(*this, det).Transpose();
+    } else {
+      S21LUT<T> lu(*this);
+      if (lu.IsSingular() ||
+          lu.ReciprocalCondition() < std::numeric_limits<T>::epsilon()) {
+        res = SingularComplements(*this);
+      } else {
+        T det = lu.Determinant();
+        S21MatrixT inverse = lu.InverseMatrix();
+        for (int i = 0; i < rows_; i++) {
+          for (int j = 0; j < cols_; j++) {
+            res.matrix_[i * cols_ + j] = det * inverse.matrix_[j * cols_ + i];
+          }
+        }
       }
     }
   }
   return res;
 }
 
-S21Matrix S21Matrix::InverseMatrix() {
+/**
+ * @brief Обратная матрица через LU-разложение.
+ * @details Вместо матрицы алгебраических дополнений (O(n^5)) решается
+ * система A * X = E по готовому разложению - O(n^3) и один рабочий буфер.
+ * Вырожденность решает не сравнение определителя с нулём, а разложение:
+ * нулевой ведущий элемент или оценка обратного числа обусловленности ниже
+ * машинного эпсилон (S21LU::ReciprocalCondition) - в обоих случаях
+ * std::invalid_argument. Поэтому обращается и хорошо обусловленная
+ * матрица с определителем, не представимым в double, и матрица с
+ * элементами разного масштаба вроде [[1e8, 1], [0, 1]]. Положительно
+ * определённая матрица обращается по разложению Холецкого с той же
+ * проверкой обусловленности. Обратная к целой матрице целая только при
+ * det(A) = +-1, иначе выбрасывается std::domain_error.
+ */
+template <typename T>
+S21MatrixT<T> S21MatrixT<T>::InverseMatrix() const {
   if (matrix_ == nullptr || cols_ < 1 || rows_ < 1) {
     throw std::out_of_range("Invalid matrix");
   }
-  double det = 0;
-  det = this->Determinant();
-  if (det == 0) {
-    throw std::invalid_argument("Determinant for this matrix is equal 0.");
+  if (rows_ != cols_) {
+    throw std::invalid_argument("Matrix should have square format.");
   }
-  S21Matrix res(rows_, cols_);
-  if (rows_ == 1) {
-    res(0, 0) = 1 / det;
+  if constexpr (std::is_integral<T>::value) {
+    T det = 0;
+    S21MatrixT res = IntegerAdjugate(*this, det);
+    if (det == 0) {
+      throw std::invalid_argument("Determinant for this matrix is equal 0.");
+    }
+    if (det != 1 && det != -1) {
+      throw std::domain_error("Inverse of this matrix is not integer.");
+    }
+    res.MulNumber(det);
+    return res;
   } else {
-    res = CalcComplements();
-    res = res.Transpose();
-    // res.MulNumber(1 / det);
-    for (int i = 0; i < cols_; i++) {
-      for (int j = 0; j < rows_; j++) {
-        res.matrix_[i][j] /= det;
+    if (MaybePositiveDefinite(*this)) {
+      S21CholeskyT<T> cholesky(*this);
+      if (cholesky.IsPositiveDefinite()) {
+        if (cholesky.ReciprocalCondition() <
+            std::numeric_limits<T>::epsilon()) {
+          throw std::invalid_argument(
+              "Matrix is singular to working precision.");
+        }
+        return cholesky.InverseMatrix();
       }
     }
+    S21LUT<T> lu(*this);
+    if (lu.IsSingular()) {
+      throw std::invalid_argument("Determinant for this matrix is equal 0.");
+    }
+    if (lu.ReciprocalCondition() < std::numeric_limits<T>::epsilon()) {
+      throw std::invalid_argument("Matrix is singular to working precision.");
+    }
+    return lu.InverseMatrix();
   }
-  return res;
 }
 
 // Перегрузка операторов
-double& S21Matrix::operator()(int row, int col) {
-  double* ptr;
-  ptr = &matrix_[row][col];
-  return *ptr;
-}
-
-S21Matrix S21Matrix::operator+(const S21Matrix& other) const {
-  S21Matrix sum = *this;
-  sum += other;
-  return sum;
+template <typename T>
+T& S21MatrixT<T>::operator()(int row, int col) {
+  return matrix_[static_cast<std::size_t>(row) * cols_ + col];
 }
 
-S21Matrix S21Matrix::operator-(const S21Matrix& other) const {
-  S21Matrix sub = *this;
-  sub -= other;
-  return sub;
+template <typename T>
+T S21MatrixT<T>::operator()(int row, int col) const {
+  return matrix_[static_cast<std::size_t>(row) * cols_ + col];
 }
 
-S21Matrix S21Matrix::operator*(const S21Matrix& other) const {
-  S21Matrix mul(*this);
-  mul.MulMatrix(other);
-  return mul;
-}
-
-S21Matrix S21Matrix::operator*(const double num) const {
-  S21Matrix mul_num = *this;
-  mul_num *= num;
-  return mul_num;
-}
-
-S21Matrix& S21Matrix::operator=(const S21Matrix& other) {
-  for (int i = 0; i < rows_; i++) {
-    delete[] matrix_[i];
-  }
-  delete[] matrix_;
-
-  this->rows_ = other.rows_;
-  this->cols_ = other.cols_;
-
-  this->AllocateMatrix();
-
-  for (int i = 0; i < other.rows_; i++) {
-    for (int j = 0; j < other.cols_; j++) {
-      matrix_[i][j] = other.matrix_[i][j];
-    }
+/**
+ * @brief Копирующее присваивание.
+ * @details Если текущего буфера хватает под данные other, они копируются
+ * в него без новой аллокации - присваивание матриц одного размера
+ * в цикле не обращается к аллокатору.
+ */
+template <typename T>
+S21MatrixT<T>& S21MatrixT<T>::operator=(const S21MatrixT& other) {
+  if (this == &other) {
+    return *this;
+  }
+  std::size_t count = static_cast<std::size_t>(other.rows_) * other.cols_;
+  if (matrix_ != nullptr && other.matrix_ != nullptr && count <= capacity_) {
+    rows_ = other.rows_;
+    cols_ = other.cols_;
+    std::copy_n(other.matrix_, count, matrix_);
+  } else {
+    S21MatrixT copy(other);
+    *this = std::move(copy);
   }
   return *this;
 }
 
-S21Matrix& S21Matrix::operator=(S21Matrix&& other) {
-  for (int i = 0; i < rows_; i++) {
-    delete[] matrix_[i];
+template <typename T>
+S21MatrixT<T>& S21MatrixT<T>::operator=(S21MatrixT&& other) {
+  if (this == &other) {
+    return *this;
   }
-  delete[] matrix_;
+  this->FreeMatrix();
   rows_ = other.rows_;
   cols_ = other.cols_;
   matrix_ = other.matrix_;
+  capacity_ = other.capacity_;
   other.rows_ = 0;
   other.cols_ = 0;
   other.matrix_ = nullptr;
+  other.capacity_ = 0;
   return *this;
 }
 
-S21Matrix& S21Matrix::operator+=(const S21Matrix& other) {
+template <typename T>
+S21MatrixT<T>& S21MatrixT<T>::operator+=(const S21MatrixT& other) {
   SumMatrix(other);
   return *this;
 }
 
-S21Matrix& S21Matrix::operator-=(const S21Matrix& other) {
+template <typename T>
+S21MatrixT<T>& S21MatrixT<T>::operator-=(const S21MatrixT& other) {
   SubMatrix(other);
   return *this;
 }
 
-S21Matrix& S21Matrix::operator*=(const S21Matrix& other) {
+template <typename T>
+S21MatrixT<T>& S21MatrixT<T>::operator*=(const S21MatrixT& other) {
   MulMatrix(other);
   return *this;
 }
 
-S21Matrix& S21Matrix::operator*=(const double num) {
+template <typename T>
+S21MatrixT<T>& S21MatrixT<T>::operator*=(const T num) {
   MulNumber(num);
   return *this;
 }
 
-bool S21Matrix::operator==(const S21Matrix& other) const noexcept {
+template <typename T>
+bool S21MatrixT<T>::operator==(const S21MatrixT& other) const noexcept {
   return EqMatrix(other);
 }
 
 // Accessors
-const int& S21Matrix::GetRows() const noexcept { return this->rows_; }
+template <typename T>
+const int& S21MatrixT<T>::GetRows() const noexcept {
+  return this->rows_;
+}
 
-const int& S21Matrix::GetCols() const noexcept { return this->cols_; }
+template <typename T>
+const int& S21MatrixT<T>::GetCols() const noexcept {
+  return this->cols_;
+}
+
+/**
+ * @brief Шаг между соседними строками в элементах.
+ * @details Буфер плотный, поэтому шаг совпадает с числом столбцов.
+ */
+template <typename T>
+int S21MatrixT<T>::GetStride() const noexcept {
+  return this->cols_;
+}
+
+template <typename T>
+T* S21MatrixT<T>::Data() noexcept {
+  return this->matrix_;
+}
+
+template <typename T>
+const T* S21MatrixT<T>::Data() const noexcept {
+  return this->matrix_;
+}
+
+template <typename T>
+std::size_t S21MatrixT<T>::GetCapacity() const noexcept {
+  return capacity_;
+}
+
+/**
+ * @brief Резервирование буфера под count элементов.
+ * @details Как std::vector::reserve: размеры и данные не меняются, а
+ * последующие SetRows/SetCols и присваивания в пределах ёмкости
+ * обходятся без аллокаций.
+ */
+template <typename T>
+void S21MatrixT<T>::Reserve(std::size_t count) {
+  if (count > capacity_) {
+    Reallocate(count, cols_);
+  }
+}
 
 // Mutators
-void S21Matrix::SetRows(int rows) {
+/**
+ * @brief Изменение числа строк с сохранением данных.
+ * @details
+ * Строки лежат подряд, поэтому при уменьшении достаточно поменять rows_,
+ * а при увеличении - дописать нулевые строки в конец буфера. Новый буфер
+ * выделяется только при нехватке ёмкости, и сразу с запасом в полтора
+ * раза: частые изменения размера обходятся амортизированно без аллокаций.
+ */
+template <typename T>
+void S21MatrixT<T>::SetRows(int rows) {
   if (rows < 1) {
     throw std::invalid_argument("Size of raws cannot be below 1");
   }
-  S21Matrix tmp(rows, cols_);
+  std::size_t count = static_cast<std::size_t>(rows) * cols_;
+  if (count > capacity_) {
+    Reallocate(std::max(count, capacity_ + capacity_ / 2), cols_);
+  }
   if (rows > rows_) {
-    for (int i = 0; i < rows; i++) {
-      for (int j = 0; j < cols_; j++) {
-        if (i < rows_) {
-          tmp.matrix_[i][j] = this->matrix_[i][j];
-        } else {
-          tmp.matrix_[i][j] = 0;
-        }
-      }
-    }
+    std::size_t old_count = static_cast<std::size_t>(rows_) * cols_;
+    s21::GetKernels<T>().zero(matrix_ + old_count, count - old_count);
   }
-  *this = tmp;
+  rows_ = rows;
 }
 
-void S21Matrix::SetCols(int cols) {
+/**
+ * @brief Изменение числа столбцов с сохранением данных.
+ * @details В пределах ёмкости строки сдвигаются на месте: при уменьшении
+ * от первой к последней, при увеличении - от последней к первой, чтобы
+ * не затереть ещё не перенесённые данные.
+ */
+template <typename T>
+void S21MatrixT<T>::SetCols(int cols) {
   if (cols < 1) {
     throw std::invalid_argument("Size of raws cannot be below 1");
   }
-  S21Matrix tmp(rows_, cols);
-  if (cols > cols_) {
-    for (int i = 0; i < rows_; i++) {
-      for (int j = 0; j < cols; j++) {
-        if (j < cols_)
-          tmp.matrix_[i][j] = this->matrix_[i][j];
-        else
-          tmp.matrix_[i][j] = 0;
-      }
+  std::size_t count = static_cast<std::size_t>(rows_) * cols;
+  if (count > capacity_) {
+    Reallocate(std::max(count, capacity_ + capacity_ / 2), cols);
+  } else if (cols < cols_) {
+    for (int i = 1; i < rows_; i++) {
+      memmove(matrix_ + static_cast<std::size_t>(i) * cols,
+              matrix_ + static_cast<std::size_t>(i) * cols_,
+              cols * sizeof(T));
     }
-  }
-  *this = tmp;
-}
-
-// Helper
-void S21Matrix::SwapRows(int row1, int row2) noexcept {
-  if (row1 != row2) {
-    for (int i = 0; i < cols_; ++i) {
-      std::swap((*this)(row1, i), (*this)(row2, i));
+  } else if (cols > cols_) {
+    for (int i = rows_ - 1; i >= 0; i--) {
+      T* dst = matrix_ + static_cast<std::size_t>(i) * cols;
+      memmove(dst, matrix_ + static_cast<std::size_t>(i) * cols_,
+              cols_ * sizeof(T));
+      std::fill(dst + cols_, dst + cols, T(0));
     }
   }
+  cols_ = cols;
 }
 
 // Destructor
-S21Matrix::~S21Matrix() {
+template <typename T>
+S21MatrixT<T>::~S21MatrixT() {
   if (matrix_ != nullptr) {
     this->FreeMatrix();
     this->matrix_ = nullptr;
     this->cols_ = 0;
     this->rows_ = 0;
+    this->capacity_ = 0;
   }
 }
+
+template class S21MatrixT<float>;
+template class S21MatrixT<double>;
+template class S21MatrixT<long double>;
+template class S21MatrixT<std::int64_t>;
+
+namespace s21 {
+/**
+ * @brief Произведение матриц.
+ * @details Представления передаются со своими шагами, без копий.
+ */
+template <typename T>
+S21MatrixT<T> Multiply(const S21MatrixViewT<const T>& a,
+                       const S21MatrixViewT<const T>& b) {
+  return MultiplyStrided(a.GetRows(), a.GetCols(), b.GetCols(), a.Data(),
+                         a.GetRowStride(), a.GetColStride(), b.Data(),
+                         b.GetRows(), b.GetRowStride(), b.GetColStride());
+}
+
+template <typename T>
+S21MatrixT<T> Multiply(const S21MatrixT<T>& a, const S21MatrixT<T>& b) {
+  return MultiplyStrided(a.GetRows(), a.GetCols(), b.GetCols(), a.Data(),
+                         a.GetStride(), 1, b.Data(), b.GetRows(),
+                         b.GetStride(), 1);
+}
+
+#define S21_MULTIPLY_INSTANTIATE(T)                                    \
+  template S21MatrixT<T> Multiply(const S21MatrixViewT<const T>& a,    \
+                                  const S21MatrixViewT<const T>& b);   \
+  template S21MatrixT<T> Multiply(const S21MatrixT<T>& a,              \
+                                  const S21MatrixT<T>& b);
+
+S21_MULTIPLY_INSTANTIATE(float)
+S21_MULTIPLY_INSTANTIATE(double)
+S21_MULTIPLY_INSTANTIATE(long double)
+S21_MULTIPLY_INSTANTIATE(std::int64_t)
+#undef S21_MULTIPLY_INSTANTIATE
+}  // namespace s21
@@ -4,61 +4,200 @@
 #include <math.h>
 #include <string.h>
 
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <memory>
+#include <type_traits>
+
+#include "s21_allocator.h"
+
+namespace s21 {
+// Общая база узлов ленивых выражений (см. s21_matrix_expr.h)
+struct MatrixExprTag {};
+template <typename T>
+using IsExprNode = std::is_base_of<MatrixExprTag, T>;
+
+/**
+ * @brief Допуски для типа элементов T.
+ * @details kEpsilon - допуск сравнения в EqMatrix, kPivotEpsilon -
+ * относительный порог: ведущий элемент не больше kPivotEpsilon * max|a_ij|
+ * считается нулём при определении ранга в CalcComplements (S21LU и
+ * s21::Solve вырожденной считают только матрицу с точно нулевым ведущим
+ * элементом, а дальше решает оценка обусловленности). Для double это
+ * прежние 1e-7, для float и long double порог взят по их точности: около
+ * корня из машинного эпсилон, как 1e-7 для double. Целые матрицы
+ * сравниваются точно, а определитель считается без деления с остатком.
+ * Real - вещественный тип для логарифма определителя.
+ */
+template <typename T>
+struct ScalarTraits;
+
+template <>
+struct ScalarTraits<float> {
+  using Real = float;
+  static constexpr float kEpsilon = 1e-4f;
+  static constexpr float kPivotEpsilon = 1e-4f;
+};
+
+template <>
+struct ScalarTraits<double> {
+  using Real = double;
+  static constexpr double kEpsilon = 1e-7;
+  static constexpr double kPivotEpsilon = 1e-7;
+};
+
+template <>
+struct ScalarTraits<long double> {
+  using Real = long double;
+  static constexpr long double kEpsilon = 1e-10L;
+  static constexpr long double kPivotEpsilon = 1e-10L;
+};
+
+template <>
+struct ScalarTraits<std::int64_t> {
+  using Real = double;
+  static constexpr std::int64_t kEpsilon = 0;
+  static constexpr std::int64_t kPivotEpsilon = 0;
+};
+
+// Определитель в виде det A = sign * exp(log_abs), sign - 1, -1 или 0
+template <typename T>
+struct LogDeterminant {
+  int sign;
+  T log_abs;
+};
+}  // namespace s21
+
+template <typename T>
+class S21MatrixViewT;
+template <typename T>
+class S21CholeskyT;
+
+/**
+ * @brief Матрица с элементами типа T.
+ * @details Определена для float, double, long double и std::int64_t,
+ * S21Matrix - матрица double. Для целых матриц определитель и
+ * алгебраические дополнения считаются точно, а обратная существует
+ * только при определителе, равном 1 или -1.
+ */
+template <typename T>
+class S21MatrixT final {
+  static_assert(std::is_same<T, float>::value ||
+                    std::is_same<T, double>::value ||
+                    std::is_same<T, long double>::value ||
+                    std::is_same<T, std::int64_t>::value,
+                "Element type must be float, double, long double or int64_t");
 
-class S21Matrix final {
  private:
   int rows_, cols_;
-  double** matrix_;
+  T* matrix_;
+  // Размер буфера в элементах, не меньше rows_ * cols_
+  std::size_t capacity_;
 
-  S21Matrix CalcMinorMat(int i_ignore, int j_ignore);
-  void SwapRows(int row1, int row2) noexcept;
-  bool CheckMatrix(const S21Matrix& other) const noexcept;
+  bool CheckMatrix(const S21MatrixT& other) const noexcept;
   void AllocateMatrix();
   void FreeMatrix();
+  void Reallocate(std::size_t capacity, int cols);
   void FillWithZeroes() noexcept;
 
  public:
-  S21Matrix() noexcept;
-  explicit S21Matrix(int rows, int cols);
-  S21Matrix(const S21Matrix& other);
-  S21Matrix(S21Matrix&& other) noexcept;
-  ~S21Matrix();
-
-  bool EqMatrix(const S21Matrix& other) const noexcept;
-  void SumMatrix(const S21Matrix& other);
-  void SubMatrix(const S21Matrix& other);
-  void MulNumber(const double num);
-  void MulMatrix(const S21Matrix& other);
-
-  double& operator()(int row, int col);
-  S21Matrix operator+(const S21Matrix& other) const;
-  S21Matrix operator-(const S21Matrix& other) const;
-  S21Matrix operator*(const S21Matrix& other) const;
-  S21Matrix operator*(const double num) const;
-
-  S21Matrix& operator=(const S21Matrix& other);
-  S21Matrix& operator=(S21Matrix&& other);
-  S21Matrix& operator+=(const S21Matrix& other);
-  S21Matrix& operator-=(const S21Matrix& other);
-  S21Matrix& operator*=(const S21Matrix& other);
-  S21Matrix& operator*=(const double num);
-  bool operator==(const S21Matrix& other) const noexcept;
-
-  void SwapMatrix(const S21Matrix& other);
-  S21Matrix Transpose();
-  S21Matrix CalcComplements();
-  double Determinant();
-  S21Matrix InverseMatrix();
+  using value_type = T;
+
+  S21MatrixT() noexcept;
+  explicit S21MatrixT(int rows, int cols);
+  S21MatrixT(const S21MatrixT& other);
+  S21MatrixT(S21MatrixT&& other) noexcept;
+  template <typename E,
+            typename = std::enable_if_t<s21::IsExprNode<E>::value>>
+  S21MatrixT(const E& expr);
+  ~S21MatrixT();
+
+  bool EqMatrix(const S21MatrixT& other) const noexcept;
+  void SumMatrix(const S21MatrixT& other);
+  void SubMatrix(const S21MatrixT& other);
+  void MulNumber(const T num);
+  void MulMatrix(const S21MatrixT& other);
+
+  T& operator()(int row, int col);
+  T operator()(int row, int col) const;
+
+  S21MatrixT& operator=(const S21MatrixT& other);
+  S21MatrixT& operator=(S21MatrixT&& other);
+  template <typename E,
+            typename = std::enable_if_t<s21::IsExprNode<E>::value>>
+  S21MatrixT& operator=(const E& expr);
+  S21MatrixT& operator+=(const S21MatrixT& other);
+  S21MatrixT& operator-=(const S21MatrixT& other);
+  template <typename E,
+            typename = std::enable_if_t<s21::IsExprNode<E>::value>>
+  S21MatrixT& operator+=(const E& expr);
+  template <typename E,
+            typename = std::enable_if_t<s21::IsExprNode<E>::value>>
+  S21MatrixT& operator-=(const E& expr);
+  S21MatrixT& operator*=(const S21MatrixT& other);
+  S21MatrixT& operator*=(const T num);
+  bool operator==(const S21MatrixT& other) const noexcept;
+
+  void SwapMatrix(const S21MatrixT& other);
+  S21MatrixT Transpose() const;
+  void TransposeInPlace();
+  S21MatrixT CalcComplements() const;
+  T Determinant() const;
+  s21::LogDeterminant<typename s21::ScalarTraits<T>::Real> LogAbsDeterminant()
+      const;
+  S21MatrixT InverseMatrix() const;
+  /**
+   * @brief Разложение Холецкого (s21_cholesky.h) для вещественной
+   * симметричной матрицы.
+   * @details Не бросает исключение, если матрица не положительно
+   * определена, - это сообщает IsPositiveDefinite() результата.
+   */
+  template <typename U = T,
+            typename = std::enable_if_t<std::is_floating_point<U>::value>>
+  S21CholeskyT<T> Cholesky() const;
   const int& GetRows() const noexcept;
   const int& GetCols() const noexcept;
+  int GetStride() const noexcept;
+  T* Data() noexcept;
+  const T* Data() const noexcept;
+  std::size_t GetCapacity() const noexcept;
+  void Reserve(std::size_t count);
   void SetRows(int rows_);
   void SetCols(int cols_);
 };
 
+using S21Matrix = S21MatrixT<double>;
+using S21MatrixF = S21MatrixT<float>;
+using S21MatrixLD = S21MatrixT<long double>;
+using S21MatrixI64 = S21MatrixT<std::int64_t>;
+
+// Методы определены в s21_matrix_oop.cpp для этих четырёх типов
+extern template class S21MatrixT<float>;
+extern template class S21MatrixT<double>;
+extern template class S21MatrixT<long double>;
+extern template class S21MatrixT<std::int64_t>;
+
 namespace s21 {
 enum { FAILED, PASSED };
+// Выравнивание буфера матрицы в байтах (одна кэш-линия)
+constexpr std::size_t kMatrixAlignment = 64;
+
+/**
+ * @brief Произведение a * b в новую матрицу без копии операндов.
+ * @details Операнды - представления с любыми шагами (s21_matrix_view.h).
+ * Матрицы и представления вперемешку проще умножать через operator*.
+ */
+template <typename T>
+S21MatrixT<T> Multiply(const S21MatrixViewT<const T>& a,
+                       const S21MatrixViewT<const T>& b);
+// То же для матриц
+template <typename T>
+S21MatrixT<T> Multiply(const S21MatrixT<T>& a, const S21MatrixT<T>& b);
 };
 
+#include "s21_cholesky.h"
+#include "s21_matrix_expr.h"
+#include "s21_matrix_view.h"
+
 #endif  //__S21MATRIX_H__
\ No newline at end of file
@@ -0,0 +1,146 @@
+#ifndef __S21MATRIXVIEW_H__
+#define __S21MATRIXVIEW_H__
+
+#include <stdexcept>
+#include <type_traits>
+
+#include "s21_matrix_oop.h"
+
+/**
+ * @brief Невладеющее представление части матрицы.
+ * @details
+ * Хранит указатель на элемент (0, 0), размеры и шаги между соседними
+ * строками и столбцами в элементах. Подматрица, строка, столбец и
+ * транспонирование - это другой набор шагов над той же памятью, данные не
+ * копируются. Представление - узел ленивого выражения, поэтому участвует во
+ * всех операциях наравне с S21Matrix: V + A, V * 2.0, S21Matrix m = V,
+ * A * V.Transpose() (произведение идёт сразу по шагам, без копий).
+ *
+ * S21MatrixView разрешает запись в элементы, S21ConstMatrixView - только
+ * чтение. Представление не продлевает жизнь матрице и становится
+ * недействительным при её уничтожении или изменении размера.
+ * Определено для тех же типов элементов, что и S21MatrixT (T или const T),
+ * в выражениях участвует вместе с матрицами того же типа.
+ */
+template <typename T>
+class S21MatrixViewT final
+    : public s21::MatrixExpr<S21MatrixViewT<T>, std::remove_const_t<T>> {
+  using Value = std::remove_const_t<T>;
+
+ private:
+  T* data_;
+  int rows_, cols_;
+  int row_stride_, col_stride_;
+
+  void CheckBlock(int row, int col, int rows, int cols) const {
+    if (row < 0 || col < 0 || rows < 0 || cols < 0 || row + rows > rows_ ||
+        col + cols > cols_) {
+      throw std::out_of_range("Incorrect input, view is out of the matrix");
+    }
+  }
+
+ public:
+  S21MatrixViewT(T* data, int rows, int cols, int row_stride,
+                 int col_stride = 1)
+      : data_(data),
+        rows_(rows),
+        cols_(cols),
+        row_stride_(row_stride),
+        col_stride_(col_stride) {
+    if (rows < 0 || cols < 0 || row_stride < 0 || col_stride < 0) {
+      throw std::length_error("View size and strides must not be negative");
+    }
+  }
+  S21MatrixViewT(S21MatrixT<Value>& matrix)
+      : S21MatrixViewT(matrix.Data(), matrix.GetRows(), matrix.GetCols(),
+                       matrix.GetStride()) {}
+  template <typename U = T,
+            typename = std::enable_if_t<std::is_const<U>::value>>
+  S21MatrixViewT(const S21MatrixT<Value>& matrix)
+      : S21MatrixViewT(matrix.Data(), matrix.GetRows(), matrix.GetCols(),
+                       matrix.GetStride()) {}
+  // Изменяемое представление приводится к константному
+  template <typename U = T,
+            typename = std::enable_if_t<std::is_const<U>::value>>
+  S21MatrixViewT(const S21MatrixViewT<Value>& other)
+      : S21MatrixViewT(other.Data(), other.GetRows(), other.GetCols(),
+                       other.GetRowStride(), other.GetColStride()) {}
+
+  int GetRows() const noexcept { return rows_; }
+  int GetCols() const noexcept { return cols_; }
+  int GetRowStride() const noexcept { return row_stride_; }
+  int GetColStride() const noexcept { return col_stride_; }
+  T* Data() const noexcept { return data_; }
+
+  T& operator()(int row, int col) const noexcept {
+    return data_[static_cast<std::ptrdiff_t>(row) * row_stride_ +
+                 static_cast<std::ptrdiff_t>(col) * col_stride_];
+  }
+
+  // Подматрица [rows x cols] с левым верхним углом в (row, col)
+  S21MatrixViewT Block(int row, int col, int rows, int cols) const {
+    CheckBlock(row, col, rows, cols);
+    return {&(*this)(row, col), rows, cols, row_stride_, col_stride_};
+  }
+  S21MatrixViewT Row(int row) const { return Block(row, 0, 1, cols_); }
+  S21MatrixViewT Col(int col) const { return Block(0, col, rows_, 1); }
+  // Ленивое транспонирование - строки и столбцы меняются шагами
+  S21MatrixViewT Transpose() const noexcept {
+    return {data_, cols_, rows_, col_stride_, row_stride_};
+  }
+
+  s21::Footprint<Value> GetFootprint() const noexcept {
+    return {data_, rows_, cols_, row_stride_, col_stride_};
+  }
+  bool MayAlias(const s21::Footprint<Value>& dst) const noexcept {
+    return s21::Conflicts(GetFootprint(), dst);
+  }
+
+  /**
+   * @brief Запись значения выражения в элементы представления.
+   * @details Размеры должны совпадать. Так заполняется блок матрицы без
+   * копирования её остальной части. Если выражение читает память
+   * представления не поэлементно (например, V.Assign(V.Transpose())),
+   * оно сначала вычисляется во временную матрицу.
+   */
+  template <typename E,
+            typename = std::enable_if_t<s21::IsExprNode<E>::value>>
+  const S21MatrixViewT& Assign(const E& expr) const {
+    static_assert(!std::is_const<T>::value, "Cannot assign to a const view");
+    if (rows_ != expr.GetRows() || cols_ != expr.GetCols()) {
+      throw std::out_of_range(
+          "Incorrect input, matricex should have the same size");
+    }
+    if (expr.MayAlias(GetFootprint())) {
+      return Assign(S21MatrixT<Value>(expr));
+    }
+    for (int i = 0; i < rows_; ++i) {
+      for (int j = 0; j < cols_; ++j) {
+        (*this)(i, j) = expr(i, j);
+      }
+    }
+    return *this;
+  }
+  const S21MatrixViewT& Assign(const S21MatrixT<Value>& matrix) const {
+    return Assign(s21::MatrixLeaf<Value>(matrix));
+  }
+};
+
+using S21MatrixView = S21MatrixViewT<double>;
+using S21ConstMatrixView = S21MatrixViewT<const double>;
+using S21MatrixViewF = S21MatrixViewT<float>;
+using S21ConstMatrixViewF = S21MatrixViewT<const float>;
+using S21MatrixViewLD = S21MatrixViewT<long double>;
+using S21ConstMatrixViewLD = S21MatrixViewT<const long double>;
+
+namespace s21 {
+// Представление передаётся в произведение и сравнение без копии
+template <typename T>
+struct Materializer<S21MatrixViewT<T>> {
+  static const S21MatrixViewT<T>& Get(const S21MatrixViewT<T>& view) {
+    return view;
+  }
+};
+}  // namespace s21
+
+#endif  //__S21MATRIXVIEW_H__
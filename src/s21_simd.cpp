@@ -0,0 +1,652 @@
+#include "s21_simd.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define S21_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+// Скалярные ядра - общий запасной вариант и досчёт хвостов
+template <typename T>
+void AddScalar(T* dst, const T* src, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    dst[i] += src[i];
+  }
+}
+
+template <typename T>
+void SubScalar(T* dst, const T* src, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    dst[i] -= src[i];
+  }
+}
+
+template <typename T>
+void ScaleScalar(T* dst, T num, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    dst[i] *= num;
+  }
+}
+
+template <typename T>
+void ZeroScalar(T* dst, std::size_t n) {
+  std::fill_n(dst, n, T(0));
+}
+
+template <typename T>
+bool Differs(T a, T b, T eps) noexcept {
+  if constexpr (std::is_integral<T>::value) {
+    // Модуль разности в беззнаковом типе не переполняется
+    using U = std::make_unsigned_t<T>;
+    const U diff = a > b ? U(a) - U(b) : U(b) - U(a);
+    return diff > U(eps);
+  } else {
+    return std::fabs(a - b) > eps;
+  }
+}
+
+template <typename T>
+bool EqualScalar(const T* a, const T* b, std::size_t n, T eps) {
+  bool is_eq = true;
+  for (std::size_t i = 0; i < n && is_eq; ++i) {
+    if (Differs(a[i], b[i], eps)) {
+      is_eq = false;
+    }
+  }
+  return is_eq;
+}
+
+template <typename T>
+void TransposeScalar(const T* src, std::size_t src_stride, T* dst,
+                     std::size_t dst_stride) {
+  for (std::size_t i = 0; i < 4; ++i) {
+    for (std::size_t j = 0; j < 4; ++j) {
+      dst[j * dst_stride + i] = src[i * src_stride + j];
+    }
+  }
+}
+
+template <typename T>
+constexpr s21::SimdKernels<T> kScalarKernels = {
+    s21::SimdLevel::kScalar, AddScalar<T>,   SubScalar<T>, ScaleScalar<T>,
+    ZeroScalar<T>,           EqualScalar<T>, 4,            TransposeScalar<T>};
+
+#ifdef S21_SIMD_X86
+// SSE2: 2 double в регистре
+__attribute__((target("sse2"))) void AddSse2(double* dst, const double* src,
+                                             std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(dst + i,
+                  _mm_add_pd(_mm_loadu_pd(dst + i), _mm_loadu_pd(src + i)));
+  }
+  AddScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("sse2"))) void SubSse2(double* dst, const double* src,
+                                             std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(dst + i,
+                  _mm_sub_pd(_mm_loadu_pd(dst + i), _mm_loadu_pd(src + i)));
+  }
+  SubScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("sse2"))) void ScaleSse2(double* dst, double num,
+                                               std::size_t n) {
+  const __m128d factor = _mm_set1_pd(num);
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(dst + i, _mm_mul_pd(_mm_loadu_pd(dst + i), factor));
+  }
+  ScaleScalar(dst + i, num, n - i);
+}
+
+__attribute__((target("sse2"))) void ZeroSse2(double* dst, std::size_t n) {
+  const __m128d zero = _mm_setzero_pd();
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(dst + i, zero);
+  }
+  ZeroScalar(dst + i, n - i);
+}
+
+__attribute__((target("sse2"))) bool EqualSse2(const double* a,
+                                               const double* b, std::size_t n,
+                                               double eps) {
+  const __m128d sign = _mm_set1_pd(-0.0);
+  const __m128d limit = _mm_set1_pd(eps);
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    __m128d diff = _mm_sub_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i));
+    __m128d over = _mm_cmpgt_pd(_mm_andnot_pd(sign, diff), limit);
+    if (_mm_movemask_pd(over) != 0) {
+      return false;
+    }
+  }
+  return EqualScalar(a + i, b + i, n - i, eps);
+}
+
+// Блок 2x2: unpacklo/unpackhi собирают столбцы из двух строк
+__attribute__((target("sse2"))) void TransposeSse2(const double* src,
+                                                   std::size_t src_stride,
+                                                   double* dst,
+                                                   std::size_t dst_stride) {
+  const __m128d r0 = _mm_loadu_pd(src);
+  const __m128d r1 = _mm_loadu_pd(src + src_stride);
+  _mm_storeu_pd(dst, _mm_unpacklo_pd(r0, r1));
+  _mm_storeu_pd(dst + dst_stride, _mm_unpackhi_pd(r0, r1));
+}
+
+constexpr s21::ElementwiseKernels kSse2Kernels = {
+    s21::SimdLevel::kSse2, AddSse2,   SubSse2, ScaleSse2,
+    ZeroSse2,              EqualSse2, 2,       TransposeSse2};
+
+// SSE2 для float: 4 float в регистре
+__attribute__((target("sse2"))) void AddSse2(float* dst, const float* src,
+                                             std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm_storeu_ps(dst + i,
+                  _mm_add_ps(_mm_loadu_ps(dst + i), _mm_loadu_ps(src + i)));
+  }
+  AddScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("sse2"))) void SubSse2(float* dst, const float* src,
+                                             std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm_storeu_ps(dst + i,
+                  _mm_sub_ps(_mm_loadu_ps(dst + i), _mm_loadu_ps(src + i)));
+  }
+  SubScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("sse2"))) void ScaleSse2(float* dst, float num,
+                                               std::size_t n) {
+  const __m128 factor = _mm_set1_ps(num);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(dst + i), factor));
+  }
+  ScaleScalar(dst + i, num, n - i);
+}
+
+__attribute__((target("sse2"))) void ZeroSse2(float* dst, std::size_t n) {
+  const __m128 zero = _mm_setzero_ps();
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm_storeu_ps(dst + i, zero);
+  }
+  ZeroScalar(dst + i, n - i);
+}
+
+__attribute__((target("sse2"))) bool EqualSse2(const float* a, const float* b,
+                                               std::size_t n, float eps) {
+  const __m128 sign = _mm_set1_ps(-0.0f);
+  const __m128 limit = _mm_set1_ps(eps);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 diff = _mm_sub_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i));
+    __m128 over = _mm_cmpgt_ps(_mm_andnot_ps(sign, diff), limit);
+    if (_mm_movemask_ps(over) != 0) {
+      return false;
+    }
+  }
+  return EqualScalar(a + i, b + i, n - i, eps);
+}
+
+// Блок 4x4 стандартным макросом из xmmintrin.h
+__attribute__((target("sse2"))) void TransposeSse2(const float* src,
+                                                   std::size_t src_stride,
+                                                   float* dst,
+                                                   std::size_t dst_stride) {
+  __m128 r0 = _mm_loadu_ps(src);
+  __m128 r1 = _mm_loadu_ps(src + src_stride);
+  __m128 r2 = _mm_loadu_ps(src + 2 * src_stride);
+  __m128 r3 = _mm_loadu_ps(src + 3 * src_stride);
+  _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+  _mm_storeu_ps(dst, r0);
+  _mm_storeu_ps(dst + dst_stride, r1);
+  _mm_storeu_ps(dst + 2 * dst_stride, r2);
+  _mm_storeu_ps(dst + 3 * dst_stride, r3);
+}
+
+constexpr s21::SimdKernels<float> kSse2FloatKernels = {
+    s21::SimdLevel::kSse2, AddSse2,   SubSse2, ScaleSse2,
+    ZeroSse2,              EqualSse2, 4,       TransposeSse2};
+
+// AVX2: 4 double в регистре
+__attribute__((target("avx2"))) void AddAvx2(double* dst, const double* src,
+                                             std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(dst + i, _mm256_add_pd(_mm256_loadu_pd(dst + i),
+                                            _mm256_loadu_pd(src + i)));
+  }
+  AddScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("avx2"))) void SubAvx2(double* dst, const double* src,
+                                             std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(dst + i, _mm256_sub_pd(_mm256_loadu_pd(dst + i),
+                                            _mm256_loadu_pd(src + i)));
+  }
+  SubScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("avx2"))) void ScaleAvx2(double* dst, double num,
+                                               std::size_t n) {
+  const __m256d factor = _mm256_set1_pd(num);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(dst + i, _mm256_mul_pd(_mm256_loadu_pd(dst + i), factor));
+  }
+  ScaleScalar(dst + i, num, n - i);
+}
+
+__attribute__((target("avx2"))) void ZeroAvx2(double* dst, std::size_t n) {
+  const __m256d zero = _mm256_setzero_pd();
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(dst + i, zero);
+  }
+  ZeroScalar(dst + i, n - i);
+}
+
+__attribute__((target("avx2"))) bool EqualAvx2(const double* a,
+                                               const double* b, std::size_t n,
+                                               double eps) {
+  const __m256d sign = _mm256_set1_pd(-0.0);
+  const __m256d limit = _mm256_set1_pd(eps);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256d diff =
+        _mm256_sub_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i));
+    __m256d over =
+        _mm256_cmp_pd(_mm256_andnot_pd(sign, diff), limit, _CMP_GT_OQ);
+    if (_mm256_movemask_pd(over) != 0) {
+      return false;
+    }
+  }
+  return EqualScalar(a + i, b + i, n - i, eps);
+}
+
+/**
+ * @brief Блок 4x4.
+ * @details unpacklo/unpackhi дают пары соседних строк в половинах
+ * регистра, permute2f128 склеивает половины в столбцы.
+ */
+__attribute__((target("avx2"))) void TransposeAvx2(const double* src,
+                                                   std::size_t src_stride,
+                                                   double* dst,
+                                                   std::size_t dst_stride) {
+  const __m256d r0 = _mm256_loadu_pd(src);
+  const __m256d r1 = _mm256_loadu_pd(src + src_stride);
+  const __m256d r2 = _mm256_loadu_pd(src + 2 * src_stride);
+  const __m256d r3 = _mm256_loadu_pd(src + 3 * src_stride);
+  const __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+  const __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+  const __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+  const __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+  _mm256_storeu_pd(dst, _mm256_permute2f128_pd(t0, t2, 0x20));
+  _mm256_storeu_pd(dst + dst_stride, _mm256_permute2f128_pd(t1, t3, 0x20));
+  _mm256_storeu_pd(dst + 2 * dst_stride,
+                   _mm256_permute2f128_pd(t0, t2, 0x31));
+  _mm256_storeu_pd(dst + 3 * dst_stride,
+                   _mm256_permute2f128_pd(t1, t3, 0x31));
+}
+
+constexpr s21::ElementwiseKernels kAvx2Kernels = {
+    s21::SimdLevel::kAvx2, AddAvx2,   SubAvx2, ScaleAvx2,
+    ZeroAvx2,              EqualAvx2, 4,       TransposeAvx2};
+
+// AVX2 для float: 8 float в регистре
+__attribute__((target("avx2"))) void AddAvx2(float* dst, const float* src,
+                                             std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i),
+                                            _mm256_loadu_ps(src + i)));
+  }
+  AddScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("avx2"))) void SubAvx2(float* dst, const float* src,
+                                             std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(dst + i, _mm256_sub_ps(_mm256_loadu_ps(dst + i),
+                                            _mm256_loadu_ps(src + i)));
+  }
+  SubScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("avx2"))) void ScaleAvx2(float* dst, float num,
+                                               std::size_t n) {
+  const __m256 factor = _mm256_set1_ps(num);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_loadu_ps(dst + i), factor));
+  }
+  ScaleScalar(dst + i, num, n - i);
+}
+
+__attribute__((target("avx2"))) void ZeroAvx2(float* dst, std::size_t n) {
+  const __m256 zero = _mm256_setzero_ps();
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(dst + i, zero);
+  }
+  ZeroScalar(dst + i, n - i);
+}
+
+__attribute__((target("avx2"))) bool EqualAvx2(const float* a, const float* b,
+                                               std::size_t n, float eps) {
+  const __m256 sign = _mm256_set1_ps(-0.0f);
+  const __m256 limit = _mm256_set1_ps(eps);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 diff =
+        _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+    __m256 over =
+        _mm256_cmp_ps(_mm256_andnot_ps(sign, diff), limit, _CMP_GT_OQ);
+    if (_mm256_movemask_ps(over) != 0) {
+      return false;
+    }
+  }
+  return EqualScalar(a + i, b + i, n - i, eps);
+}
+
+/**
+ * @brief Блок 8x8 float.
+ * @details unpacklo/unpackhi и shuffle собирают четвёрки столбцов в
+ * половинах регистров, permute2f128 склеивает половины.
+ */
+__attribute__((target("avx2"))) void TransposeAvx2(const float* src,
+                                                   std::size_t src_stride,
+                                                   float* dst,
+                                                   std::size_t dst_stride) {
+  __m256 t[8];
+  for (std::size_t i = 0; i < 4; ++i) {
+    const __m256 r0 = _mm256_loadu_ps(src + 2 * i * src_stride);
+    const __m256 r1 = _mm256_loadu_ps(src + (2 * i + 1) * src_stride);
+    t[2 * i] = _mm256_unpacklo_ps(r0, r1);
+    t[2 * i + 1] = _mm256_unpackhi_ps(r0, r1);
+  }
+  __m256 q[8];
+  for (std::size_t h = 0; h < 2; ++h) {
+    // h = 0 - строки 0..3, h = 1 - строки 4..7
+    const __m256* p = t + 4 * h;
+    q[4 * h] = _mm256_shuffle_ps(p[0], p[2], _MM_SHUFFLE(1, 0, 1, 0));
+    q[4 * h + 1] = _mm256_shuffle_ps(p[0], p[2], _MM_SHUFFLE(3, 2, 3, 2));
+    q[4 * h + 2] = _mm256_shuffle_ps(p[1], p[3], _MM_SHUFFLE(1, 0, 1, 0));
+    q[4 * h + 3] = _mm256_shuffle_ps(p[1], p[3], _MM_SHUFFLE(3, 2, 3, 2));
+  }
+  for (std::size_t j = 0; j < 4; ++j) {
+    _mm256_storeu_ps(dst + j * dst_stride,
+                     _mm256_permute2f128_ps(q[j], q[j + 4], 0x20));
+    _mm256_storeu_ps(dst + (j + 4) * dst_stride,
+                     _mm256_permute2f128_ps(q[j], q[j + 4], 0x31));
+  }
+}
+
+constexpr s21::SimdKernels<float> kAvx2FloatKernels = {
+    s21::SimdLevel::kAvx2, AddAvx2,   SubAvx2, ScaleAvx2,
+    ZeroAvx2,              EqualAvx2, 8,       TransposeAvx2};
+
+// AVX-512: 8 double в регистре
+__attribute__((target("avx512f"))) void AddAvx512(double* dst,
+                                                  const double* src,
+                                                  std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm512_storeu_pd(dst + i, _mm512_add_pd(_mm512_loadu_pd(dst + i),
+                                            _mm512_loadu_pd(src + i)));
+  }
+  AddScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("avx512f"))) void SubAvx512(double* dst,
+                                                  const double* src,
+                                                  std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm512_storeu_pd(dst + i, _mm512_sub_pd(_mm512_loadu_pd(dst + i),
+                                            _mm512_loadu_pd(src + i)));
+  }
+  SubScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("avx512f"))) void ScaleAvx512(double* dst, double num,
+                                                    std::size_t n) {
+  const __m512d factor = _mm512_set1_pd(num);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm512_storeu_pd(dst + i, _mm512_mul_pd(_mm512_loadu_pd(dst + i), factor));
+  }
+  ScaleScalar(dst + i, num, n - i);
+}
+
+__attribute__((target("avx512f"))) void ZeroAvx512(double* dst,
+                                                   std::size_t n) {
+  const __m512d zero = _mm512_setzero_pd();
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm512_storeu_pd(dst + i, zero);
+  }
+  ZeroScalar(dst + i, n - i);
+}
+
+__attribute__((target("avx512f"))) bool EqualAvx512(const double* a,
+                                                    const double* b,
+                                                    std::size_t n,
+                                                    double eps) {
+  const __m512d limit = _mm512_set1_pd(eps);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m512d diff =
+        _mm512_sub_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i));
+    if (_mm512_cmp_pd_mask(_mm512_abs_pd(diff), limit, _CMP_GT_OQ) != 0) {
+      return false;
+    }
+  }
+  return EqualScalar(a + i, b + i, n - i, eps);
+}
+
+// Интринсики AVX-512 в GCC 12 дают ложное предупреждение о
+// неинициализированном регистре (_mm512_undefined_pd внутри заголовка)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+/**
+ * @brief Блок 8x8 в три шага.
+ * @details unpacklo/unpackhi собирают пары строк, затем shuffle_f64x2
+ * дважды переставляет 128-битные четверти: 0x88 берёт чётные четверти
+ * обоих аргументов, 0xDD - нечётные.
+ */
+__attribute__((target("avx512f"))) void TransposeAvx512(
+    const double* src, std::size_t src_stride, double* dst,
+    std::size_t dst_stride) {
+  __m512d r[8];
+  for (std::size_t i = 0; i < 8; ++i) {
+    r[i] = _mm512_loadu_pd(src + i * src_stride);
+  }
+  __m512d t[8];
+  for (std::size_t i = 0; i < 4; ++i) {
+    t[2 * i] = _mm512_unpacklo_pd(r[2 * i], r[2 * i + 1]);
+    t[2 * i + 1] = _mm512_unpackhi_pd(r[2 * i], r[2 * i + 1]);
+  }
+  // t[0], t[2], t[4], t[6] - чётные столбцы, t[1], t[3], ... - нечётные
+  for (std::size_t odd = 0; odd < 2; ++odd) {
+    const __m512d s0 = _mm512_shuffle_f64x2(t[odd], t[odd + 2], 0x88);
+    const __m512d s1 = _mm512_shuffle_f64x2(t[odd], t[odd + 2], 0xDD);
+    const __m512d s2 = _mm512_shuffle_f64x2(t[odd + 4], t[odd + 6], 0x88);
+    const __m512d s3 = _mm512_shuffle_f64x2(t[odd + 4], t[odd + 6], 0xDD);
+    _mm512_storeu_pd(dst + odd * dst_stride,
+                     _mm512_shuffle_f64x2(s0, s2, 0x88));
+    _mm512_storeu_pd(dst + (odd + 4) * dst_stride,
+                     _mm512_shuffle_f64x2(s0, s2, 0xDD));
+    _mm512_storeu_pd(dst + (odd + 2) * dst_stride,
+                     _mm512_shuffle_f64x2(s1, s3, 0x88));
+    _mm512_storeu_pd(dst + (odd + 6) * dst_stride,
+                     _mm512_shuffle_f64x2(s1, s3, 0xDD));
+  }
+}
+
+#pragma GCC diagnostic pop
+
+constexpr s21::ElementwiseKernels kAvx512Kernels = {
+    s21::SimdLevel::kAvx512, AddAvx512,   SubAvx512, ScaleAvx512,
+    ZeroAvx512,              EqualAvx512, 8,         TransposeAvx512};
+
+// AVX-512 для float: 16 float в регистре
+__attribute__((target("avx512f"))) void AddAvx512(float* dst,
+                                                  const float* src,
+                                                  std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    _mm512_storeu_ps(dst + i, _mm512_add_ps(_mm512_loadu_ps(dst + i),
+                                            _mm512_loadu_ps(src + i)));
+  }
+  AddScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("avx512f"))) void SubAvx512(float* dst,
+                                                  const float* src,
+                                                  std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    _mm512_storeu_ps(dst + i, _mm512_sub_ps(_mm512_loadu_ps(dst + i),
+                                            _mm512_loadu_ps(src + i)));
+  }
+  SubScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("avx512f"))) void ScaleAvx512(float* dst, float num,
+                                                    std::size_t n) {
+  const __m512 factor = _mm512_set1_ps(num);
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    _mm512_storeu_ps(dst + i, _mm512_mul_ps(_mm512_loadu_ps(dst + i), factor));
+  }
+  ScaleScalar(dst + i, num, n - i);
+}
+
+__attribute__((target("avx512f"))) void ZeroAvx512(float* dst,
+                                                   std::size_t n) {
+  const __m512 zero = _mm512_setzero_ps();
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    _mm512_storeu_ps(dst + i, zero);
+  }
+  ZeroScalar(dst + i, n - i);
+}
+
+__attribute__((target("avx512f"))) bool EqualAvx512(const float* a,
+                                                    const float* b,
+                                                    std::size_t n, float eps) {
+  const __m512 limit = _mm512_set1_ps(eps);
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m512 diff =
+        _mm512_sub_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i));
+    if (_mm512_cmp_ps_mask(_mm512_abs_ps(diff), limit, _CMP_GT_OQ) != 0) {
+      return false;
+    }
+  }
+  return EqualScalar(a + i, b + i, n - i, eps);
+}
+
+// Транспонирование float на этом уровне - блоками 8x8 из AVX2
+constexpr s21::SimdKernels<float> kAvx512FloatKernels = {
+    s21::SimdLevel::kAvx512, AddAvx512,   SubAvx512, ScaleAvx512,
+    ZeroAvx512,              EqualAvx512, 8,         TransposeAvx2};
+#endif  // S21_SIMD_X86
+
+// Для long double и целых векторных ядер нет
+template <typename T>
+const s21::SimdKernels<T>& KernelsFor(s21::SimdLevel) noexcept {
+  return kScalarKernels<T>;
+}
+
+template <>
+const s21::ElementwiseKernels& KernelsFor(s21::SimdLevel level) noexcept {
+  const s21::ElementwiseKernels* res = &kScalarKernels<double>;
+#ifdef S21_SIMD_X86
+  if (level == s21::SimdLevel::kAvx512) {
+    res = &kAvx512Kernels;
+  } else if (level == s21::SimdLevel::kAvx2) {
+    res = &kAvx2Kernels;
+  } else if (level == s21::SimdLevel::kSse2) {
+    res = &kSse2Kernels;
+  }
+#endif
+  return *res;
+}
+
+template <>
+const s21::SimdKernels<float>& KernelsFor(s21::SimdLevel level) noexcept {
+  const s21::SimdKernels<float>* res = &kScalarKernels<float>;
+#ifdef S21_SIMD_X86
+  if (level == s21::SimdLevel::kAvx512) {
+    res = &kAvx512FloatKernels;
+  } else if (level == s21::SimdLevel::kAvx2) {
+    res = &kAvx2FloatKernels;
+  } else if (level == s21::SimdLevel::kSse2) {
+    res = &kSse2FloatKernels;
+  }
+#endif
+  return *res;
+}
+
+// Уровень, выбранный для всех типов; -1 - ещё не выбран
+std::atomic<int> active_level{-1};
+}  // namespace
+
+namespace s21 {
+SimdLevel GetMaxSimdLevel() noexcept {
+  SimdLevel level = SimdLevel::kScalar;
+#ifdef S21_SIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    level = SimdLevel::kAvx512;
+  } else if (__builtin_cpu_supports("avx2")) {
+    level = SimdLevel::kAvx2;
+  } else if (__builtin_cpu_supports("sse2")) {
+    level = SimdLevel::kSse2;
+  }
+#endif
+  return level;
+}
+
+template <typename T>
+const SimdKernels<T>& GetKernels() noexcept {
+  int level = active_level.load(std::memory_order_acquire);
+  if (level < 0) {
+    level = static_cast<int>(GetMaxSimdLevel());
+    active_level.store(level, std::memory_order_release);
+  }
+  return KernelsFor<T>(static_cast<SimdLevel>(level));
+}
+
+template const SimdKernels<float>& GetKernels() noexcept;
+template const SimdKernels<double>& GetKernels() noexcept;
+template const SimdKernels<long double>& GetKernels() noexcept;
+template const SimdKernels<std::int64_t>& GetKernels() noexcept;
+
+SimdLevel SetSimdLevel(SimdLevel level) noexcept {
+  level = std::min(level, GetMaxSimdLevel());
+  active_level.store(static_cast<int>(level), std::memory_order_release);
+  return level;
+}
+}  // namespace s21
@@ -0,0 +1,56 @@
+#ifndef __S21SIMD_H__
+#define __S21SIMD_H__
+
+#include <cstddef>
+
+namespace s21 {
+/**
+ * @brief Набор инструкций, которым выполняются поэлементные операции.
+ */
+enum class SimdLevel { kScalar, kSse2, kAvx2, kAvx512 };
+
+/**
+ * @brief Таблица поэлементных ядер над плотными буферами длины n.
+ * @details Все ядра допускают невыровненные указатели и любую длину -
+ * хвост, не кратный ширине вектора, досчитывается скалярно. Векторные
+ * варианты есть для double и float (в регистр входит вдвое больше
+ * элементов), для long double и std::int64_t ядра скалярные.
+ */
+template <typename T>
+struct SimdKernels {
+  SimdLevel level;
+  void (*add)(T* dst, const T* src, std::size_t n);
+  void (*sub)(T* dst, const T* src, std::size_t n);
+  void (*scale)(T* dst, T num, std::size_t n);
+  void (*zero)(T* dst, std::size_t n);
+  // true, если |a[i] - b[i]| <= eps для всех i; выход на первом отличии
+  bool (*equal)(const T* a, const T* b, std::size_t n, T eps);
+  // Транспонирование квадратного блока transpose_tile x transpose_tile
+  // в регистрах; шаги строк src и dst - в элементах
+  int transpose_tile;
+  void (*transpose)(const T* src, std::size_t src_stride, T* dst,
+                    std::size_t dst_stride);
+};
+
+using ElementwiseKernels = SimdKernels<double>;
+
+/**
+ * @brief Ядра для текущего процессора и типа элементов T.
+ * @details Выбор делается один раз при первом вызове по CPUID: AVX-512,
+ * затем AVX2, затем SSE2, иначе скалярный код. Один и тот же бинарник
+ * использует лучший доступный вариант на каждой машине. Определены для
+ * float, double, long double и std::int64_t.
+ */
+template <typename T = double>
+const SimdKernels<T>& GetKernels() noexcept;
+
+SimdLevel GetMaxSimdLevel() noexcept;
+/**
+ * @brief Принудительный выбор уровня (для тестов и замеров).
+ * @details Уровень выше поддерживаемого процессором понижается до
+ * максимального доступного. Возвращает установленный уровень.
+ */
+SimdLevel SetSimdLevel(SimdLevel level) noexcept;
+}  // namespace s21
+
+#endif  //__S21SIMD_H__
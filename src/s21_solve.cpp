@@ -0,0 +1,275 @@
+#include "s21_solve.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "s21_cholesky.h"
+#include "s21_gemm.h"
+#include "s21_lu.h"
+#include "s21_thread_pool.h"
+
+namespace {
+// Строк A в диагональном блоке: подстановка в блоке, остальное - Gemm
+constexpr int kSolveBlock = 64;
+// Столбцов X в одной задаче пула
+constexpr int kSolveStrip = 128;
+
+// Подстановка в диагональном блоке [first, last) для m столбцов X
+template <typename T>
+void SolveDiagonalBlock(bool lower, bool unit_diagonal, int first, int last,
+                        int m, const T* a, int rs, int cs, T* x, int ldx) {
+  auto element = [&](int i, int k) {
+    return a[static_cast<std::ptrdiff_t>(i) * rs +
+             static_cast<std::ptrdiff_t>(k) * cs];
+  };
+  for (int step = 0; step < last - first; ++step) {
+    const int i = lower ? first + step : last - 1 - step;
+    T* row = x + static_cast<std::ptrdiff_t>(i) * ldx;
+    const int begin = lower ? first : i + 1;
+    const int end = lower ? i : last;
+    for (int k = begin; k < end; ++k) {
+      const T a_ik = element(i, k);
+      const T* src = x + static_cast<std::ptrdiff_t>(k) * ldx;
+      for (int j = 0; j < m; ++j) {
+        row[j] -= a_ik * src[j];
+      }
+    }
+    if (!unit_diagonal) {
+      const T a_ii = element(i, i);
+      for (int j = 0; j < m; ++j) {
+        row[j] /= a_ii;
+      }
+    }
+  }
+}
+
+// Треугольная система для полосы из m столбцов X
+template <typename T>
+void SolveStrip(bool lower, bool unit_diagonal, int n, int m, const T* a,
+                int rs, int cs, T* x, int ldx) {
+  for (int done = 0; done < n; done += kSolveBlock) {
+    // Нижняя идёт сверху вниз, верхняя - снизу вверх
+    const int first = lower ? done : std::max(0, n - done - kSolveBlock);
+    const int last = lower ? std::min(n, done + kSolveBlock) : n - done;
+    SolveDiagonalBlock(lower, unit_diagonal, first, last, m, a, rs, cs, x,
+                       ldx);
+    const int rest_first = lower ? last : 0;
+    const int rest_rows = lower ? n - last : first;
+    if (rest_rows > 0) {
+      s21::Gemm(rest_rows, m, last - first, T(-1),
+                a + static_cast<std::ptrdiff_t>(rest_first) * rs +
+                    static_cast<std::ptrdiff_t>(first) * cs,
+                rs, cs, x + static_cast<std::ptrdiff_t>(first) * ldx, ldx, 1,
+                T(1), x + static_cast<std::ptrdiff_t>(rest_first) * ldx, ldx);
+    }
+  }
+}
+
+template <typename T>
+void CheckSystem(const S21MatrixT<T>& a, const S21MatrixT<T>& b) {
+  if (a.Data() == nullptr || a.GetRows() < 1 || a.GetCols() < 1) {
+    throw std::out_of_range("Invalid matrix");
+  }
+  if (a.GetRows() != a.GetCols()) {
+    throw std::invalid_argument("Matrix should have square format.");
+  }
+  if (b.GetRows() != a.GetRows() || b.GetCols() < 1) {
+    throw std::invalid_argument(
+        "Incorrect input, right-hand side should have the same rows count");
+  }
+}
+
+/**
+ * @brief Вид матрицы для SolveMethod::kAuto за один проход.
+ * @details Диагональная матрица считается нижнетреугольной. Для
+ * положительно определённой проверяются только необходимые условия -
+ * точная симметрия и положительная диагональ, остальное выясняет
+ * разложение Холецкого.
+ */
+template <typename T>
+s21::SolveMethod DetectMethod(const S21MatrixT<T>& a) {
+  const int n = a.GetRows();
+  bool lower = true, upper = true, symmetric = true, positive = true;
+  for (int i = 0; i < n; ++i) {
+    positive = positive && a(i, i) > T(0);
+    for (int j = i + 1; j < n; ++j) {
+      const T above = a(i, j), below = a(j, i);
+      lower = lower && above == T(0);
+      upper = upper && below == T(0);
+      symmetric = symmetric && above == below;
+    }
+  }
+  s21::SolveMethod res = s21::SolveMethod::kGeneral;
+  if (lower) {
+    res = s21::SolveMethod::kLowerTriangular;
+  } else if (upper) {
+    res = s21::SolveMethod::kUpperTriangular;
+  } else if (symmetric && positive) {
+    res = s21::SolveMethod::kPositiveDefinite;
+  }
+  return res;
+}
+
+// Решение с обратным числом обусловленности ниже эпсилон не имеет смысла
+template <typename T>
+void CheckCondition(T rcond) {
+  if (rcond < std::numeric_limits<T>::epsilon()) {
+    throw std::invalid_argument("Matrix is singular to working precision.");
+  }
+}
+
+/**
+ * @brief Вырожденность треугольной матрицы, как в S21LU.
+ * @details Вырожденная - только с нулевым или не конечным элементом
+ * диагонали. Малый элемент сам по себе ничего не значит: годность решения
+ * решает оценка числа обусловленности по s21::EstimateInverseNorm, для
+ * которой A^T - та же память с переставленными шагами.
+ */
+template <typename T>
+void CheckTriangular(const S21MatrixT<T>& a, bool lower) {
+  const int n = a.GetRows(), stride = a.GetStride();
+  std::vector<T> column_sums(n, T(0));
+  for (int i = 0; i < n; ++i) {
+    if (!(std::abs(a(i, i)) > T(0)) || !std::isfinite(a(i, i))) {
+      throw std::invalid_argument("Determinant for this matrix is equal 0.");
+    }
+    for (int j = lower ? 0 : i; j <= (lower ? i : n - 1); ++j) {
+      column_sums[j] += std::abs(a(i, j));
+    }
+  }
+  const T norm = *std::max_element(column_sums.begin(), column_sums.end());
+  const T inverse_norm = s21::EstimateInverseNorm<T>(
+      n,
+      [&](T* x) {
+        s21::TriangularSolve(lower, false, n, 1, a.Data(), stride, 1, x, 1);
+      },
+      [&](T* x) {
+        s21::TriangularSolve(!lower, false, n, 1, a.Data(), 1, stride, x, 1);
+      });
+  CheckCondition(T(1) / (norm * inverse_norm));
+}
+
+// Общий случай: LU, затем проверка обусловленности
+template <typename T>
+void SolveGeneral(const S21MatrixT<T>& a, S21MatrixT<T>& x) {
+  S21LUT<T> lu(a);
+  if (lu.IsSingular()) {
+    throw std::invalid_argument("Determinant for this matrix is equal 0.");
+  }
+  CheckCondition(lu.ReciprocalCondition());
+  lu.SolveInPlace(x);
+}
+}  // namespace
+
+namespace s21 {
+template <typename T>
+void TriangularSolve(bool lower, bool unit_diagonal, int n, int m, const T* a,
+                     int a_row_stride, int a_col_stride, T* x,
+                     int x_row_stride) {
+  if (n <= 0 || m <= 0) {
+    return;
+  }
+  ThreadPool::Global().ParallelFor(
+      (m + kSolveStrip - 1) / kSolveStrip, [&](int strip) {
+        const int first = strip * kSolveStrip;
+        SolveStrip(lower, unit_diagonal, n, std::min(kSolveStrip, m - first),
+                   a, a_row_stride, a_col_stride, x + first, x_row_stride);
+      });
+}
+
+template <typename T>
+S21MatrixT<T> Solve(const S21MatrixT<T>& a, const S21MatrixT<T>& b,
+                    SolveMethod method) {
+  static_assert(std::is_floating_point<T>::value,
+                "Solve needs a floating point element type");
+  CheckSystem(a, b);
+  const int n = a.GetRows(), m = b.GetCols();
+  const bool automatic = method == SolveMethod::kAuto;
+  if (automatic) {
+    method = DetectMethod(a);
+  }
+  S21MatrixT<T> x(b);
+  if (method == SolveMethod::kLowerTriangular ||
+      method == SolveMethod::kUpperTriangular) {
+    const bool lower = method == SolveMethod::kLowerTriangular;
+    CheckTriangular(a, lower);
+    TriangularSolve(lower, false, n, m, a.Data(), a.GetStride(), 1, x.Data(),
+                    x.GetStride());
+  } else if (method == SolveMethod::kPositiveDefinite) {
+    S21CholeskyT<T> cholesky(a);
+    if (cholesky.IsPositiveDefinite() || !automatic) {
+      CheckCondition(cholesky.ReciprocalCondition());
+      cholesky.SolveInPlace(x);
+    } else {
+      SolveGeneral(a, x);
+    }
+  } else {
+    SolveGeneral(a, x);
+  }
+  return x;
+}
+
+template <typename T>
+T EstimateInverseNorm(int n, const std::function<void(T*)>& solve,
+                      const std::function<void(T*)>& solve_transposed) {
+  constexpr int kMaxIterations = 5;
+  std::vector<T> x(n, T(1) / n), y(n), z(n);
+  auto solve_norm = [&]() {
+    y = x;
+    solve(y.data());
+    T norm = T(0);
+    for (T value : y) {
+      norm += std::abs(value);
+    }
+    return norm;
+  };
+  T estimate = T(0);
+  for (int iter = 0; iter < kMaxIterations; ++iter) {
+    const T norm = solve_norm();
+    if (iter > 0 && norm <= estimate) {
+      break;
+    }
+    estimate = norm;
+    for (int i = 0; i < n; ++i) {
+      z[i] = y[i] < T(0) ? T(-1) : T(1);
+    }
+    solve_transposed(z.data());
+    int top = 0;
+    T dot = T(0);
+    for (int i = 0; i < n; ++i) {
+      dot += z[i] * x[i];
+      if (std::abs(z[i]) > std::abs(z[top])) {
+        top = i;
+      }
+    }
+    if (iter > 0 && std::abs(z[top]) <= dot) {
+      break;
+    }
+    std::fill(x.begin(), x.end(), T(0));
+    x[top] = T(1);
+  }
+  for (int i = 0; i < n; ++i) {
+    x[i] = (i % 2 ? T(-1) : T(1)) * (T(1) + T(i) / std::max(n - 1, 1));
+  }
+  return std::max(estimate, 2 * solve_norm() / (3 * n));
+}
+
+#define S21_SOLVE_INSTANTIATE(T)                                             \
+  template void TriangularSolve(bool lower, bool unit_diagonal, int n, int m, \
+                                const T* a, int a_row_stride,                \
+                                int a_col_stride, T* x, int x_row_stride);   \
+  template S21MatrixT<T> Solve(const S21MatrixT<T>& a,                       \
+                               const S21MatrixT<T>& b, SolveMethod method); \
+  template T EstimateInverseNorm(                                            \
+      int n, const std::function<void(T*)>& solve,                           \
+      const std::function<void(T*)>& solve_transposed);
+
+S21_SOLVE_INSTANTIATE(float)
+S21_SOLVE_INSTANTIATE(double)
+S21_SOLVE_INSTANTIATE(long double)
+#undef S21_SOLVE_INSTANTIATE
+}  // namespace s21
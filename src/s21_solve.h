@@ -0,0 +1,75 @@
+#ifndef __S21SOLVE_H__
+#define __S21SOLVE_H__
+
+#include <functional>
+
+#include "s21_matrix_oop.h"
+
+namespace s21 {
+/**
+ * @brief Способ решения A * X = B в s21::Solve.
+ * @details kAuto выбирает способ по виду A за O(n^2): треугольная -
+ * подстановкой, симметричная с положительной диагональю - разложением
+ * Холецкого (если оно не удалось, матрица не положительно определена и
+ * решается через LU), остальные - LU с выбором главного элемента.
+ */
+enum class SolveMethod {
+  kAuto,
+  kGeneral,
+  kLowerTriangular,
+  kUpperTriangular,
+  kPositiveDefinite
+};
+
+/**
+ * @brief Треугольная система A * X = B на месте: X записывается поверх B.
+ * @details
+ * Столбцы X независимы, поэтому делятся полосами между потоками пула.
+ * В полосе строки A идут блоками: диагональный блок - подстановкой, а
+ * остальные строки X обновляются одним произведением через s21::Gemm,
+ * так что почти вся работа - блочное умножение. A задаётся шагами по
+ * строке и столбцу: транспонированный треугольник (например, L^T из
+ * разложения Холецкого) передаётся без копии. Определено для float,
+ * double и long double.
+ * @param lower A нижнетреугольная (иначе верхнетреугольная)
+ * @param unit_diagonal диагональ A считается единичной и не читается
+ * @param n порядок A и число строк X
+ * @param m число столбцов X
+ */
+template <typename T>
+void TriangularSolve(bool lower, bool unit_diagonal, int n, int m, const T* a,
+                     int a_row_stride, int a_col_stride, T* x,
+                     int x_row_stride);
+
+/**
+ * @brief Решение A * X = B для всех столбцов B сразу.
+ * @details Вырожденная A (нулевой ведущий элемент или элемент диагонали
+ * треугольной матрицы) и A с оценкой обратного числа обусловленности ниже
+ * машинного эпсилон - std::invalid_argument, как в InverseMatrix; при
+ * kPositiveDefinite и не положительно определённой A - тоже. Дешевле и
+ * точнее, чем A.InverseMatrix() * B. Определено для float, double и
+ * long double.
+ * @param b правая часть [n x m]
+ */
+template <typename T>
+S21MatrixT<T> Solve(const S21MatrixT<T>& a, const S21MatrixT<T>& b,
+                    SolveMethod method = SolveMethod::kAuto);
+
+/**
+ * @brief Оценка ||A^-1||_1 по Хейгеру и Хайему без построения A^-1.
+ * @details
+ * Как dlacn2 в LAPACK: на каждой итерации решаются A * y = x и
+ * A^T * z = sign(y), а x переходит в столбец единичной матрицы, где |z|
+ * наибольший. Обычно хватает двух - трёх итераций по O(n^2). Оценка
+ * снизу и редко ошибается больше чем в несколько раз, в конце она
+ * сверяется с альтернативным вектором Хайема. Определено для float,
+ * double и long double.
+ * @param solve заменяет столбец x длины n на A^-1 * x
+ * @param solve_transposed заменяет x на A^-T * x
+ */
+template <typename T>
+T EstimateInverseNorm(int n, const std::function<void(T*)>& solve,
+                      const std::function<void(T*)>& solve_transposed);
+}  // namespace s21
+
+#endif  //__S21SOLVE_H__
@@ -0,0 +1,608 @@
+#include "s21_sparse_matrix.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_simd.h"
+#include "s21_thread_pool.h"
+
+namespace {
+// Произведения с меньшим числом умножений считаются в одном потоке
+constexpr std::size_t kParallelSparseWork = std::size_t(1) << 16;
+// Строк результата на одну задачу пула
+constexpr int kRowsPerTask = 64;
+
+/**
+ * @brief Массивы разреженной матрицы в одном формате.
+ * @details major - число строк для CSR (столбцов для CSC), minor - длина
+ * строки. Все алгоритмы ниже записаны для CSR: CSC матрицы A - это CSR
+ * матрицы A^T с теми же массивами.
+ */
+struct Compressed {
+  int major, minor;
+  std::vector<int> offsets;
+  std::vector<int> indices;
+  std::vector<double> values;
+};
+
+/**
+ * @brief Смена порядка хранения (CSR <-> CSC) подсчётом.
+ * @details Один проход считает элементы в каждой строке нового порядка,
+ * второй раскладывает их. Элементы перебираются по возрастанию старой
+ * строки, поэтому индексы в новых строках сразу отсортированы.
+ * O(nnz + major + minor).
+ */
+Compressed Transposed(int major, int minor, const std::vector<int>& offsets,
+                      const std::vector<int>& indices,
+                      const std::vector<double>& values) {
+  Compressed res{minor, major, std::vector<int>(minor + 1, 0),
+                 std::vector<int>(indices.size()),
+                 std::vector<double>(values.size())};
+  for (int index : indices) {
+    ++res.offsets[index + 1];
+  }
+  for (int i = 0; i < minor; ++i) {
+    res.offsets[i + 1] += res.offsets[i];
+  }
+  std::vector<int> cursor(res.offsets.begin(), res.offsets.end() - 1);
+  for (int i = 0; i < major; ++i) {
+    for (int p = offsets[i]; p < offsets[i + 1]; ++p) {
+      const int dst = cursor[indices[p]]++;
+      res.indices[dst] = i;
+      res.values[dst] = values[p];
+    }
+  }
+  return res;
+}
+
+/**
+ * @brief Произведение CSR [rows x inner] на CSR [inner x cols] (Gustavson).
+ * @details Строка результата собирается в плотном аккумуляторе длины
+ * cols: для каждого a(i, k) к нему прибавляется строка k матрицы b,
+ * затронутые столбцы запоминаются и сортируются. Время - O(числа
+ * умножений + nnz результата * log), память - O(cols) сверх результата.
+ */
+Compressed Gustavson(int rows, int cols, const std::vector<int>& a_offsets,
+                     const std::vector<int>& a_indices,
+                     const std::vector<double>& a_values,
+                     const std::vector<int>& b_offsets,
+                     const std::vector<int>& b_indices,
+                     const std::vector<double>& b_values) {
+  Compressed res{rows, cols, std::vector<int>(rows + 1, 0), {}, {}};
+  std::vector<double> acc(cols, 0.0);
+  std::vector<char> touched(cols, 0);
+  std::vector<int> pattern;
+  for (int i = 0; i < rows; ++i) {
+    for (int p = a_offsets[i]; p < a_offsets[i + 1]; ++p) {
+      const int k = a_indices[p];
+      const double a = a_values[p];
+      for (int q = b_offsets[k]; q < b_offsets[k + 1]; ++q) {
+        const int j = b_indices[q];
+        if (!touched[j]) {
+          touched[j] = 1;
+          pattern.push_back(j);
+        }
+        acc[j] += a * b_values[q];
+      }
+    }
+    std::sort(pattern.begin(), pattern.end());
+    for (int j : pattern) {
+      if (acc[j] != 0.0) {
+        res.indices.push_back(j);
+        res.values.push_back(acc[j]);
+      }
+      acc[j] = 0.0;
+      touched[j] = 0;
+    }
+    pattern.clear();
+    res.offsets[i + 1] = static_cast<int>(res.indices.size());
+  }
+  return res;
+}
+
+// Вызов body(first, last) для строк [0, rows) блоками на пуле потоков
+template <typename Body>
+void ForRows(int rows, std::size_t work, const Body& body) {
+  s21::ThreadPool& pool = s21::ThreadPool::Global();
+  if (pool.GetThreadCount() == 1 || work < kParallelSparseWork ||
+      rows <= kRowsPerTask) {
+    body(0, rows);
+  } else {
+    pool.ParallelFor((rows + kRowsPerTask - 1) / kRowsPerTask, [&](int task) {
+      const int first = task * kRowsPerTask;
+      body(first, std::min(rows, first + kRowsPerTask));
+    });
+  }
+}
+}  // namespace
+
+S21SparseMatrix::S21SparseMatrix()
+    : rows_(0), cols_(0), format_(S21SparseFormat::kCsr), offsets_{0} {}
+
+S21SparseMatrix::S21SparseMatrix(int rows, int cols, S21SparseFormat format)
+    : rows_(rows), cols_(cols), format_(format) {
+  if (rows < 0 || cols < 0) {
+    throw std::length_error("Matrix size must be greater than 0");
+  }
+  offsets_.assign(GetMajor() + 1, 0);
+}
+
+S21SparseMatrix::S21SparseMatrix(int rows, int cols, S21SparseFormat format,
+                                 std::vector<int> offsets,
+                                 std::vector<int> indices,
+                                 std::vector<double> values)
+    : rows_(rows),
+      cols_(cols),
+      format_(format),
+      offsets_(std::move(offsets)),
+      indices_(std::move(indices)),
+      values_(std::move(values)) {
+  if (rows < 0 || cols < 0) {
+    throw std::length_error("Matrix size must be greater than 0");
+  }
+  CheckStructure();
+}
+
+/**
+ * @brief Разреженная копия плотной матрицы.
+ * @details В матрицу попадают элементы, не равные нулю точно. Для CSC
+ * сначала собирается CSR, затем порядок меняется подсчётом - плотная
+ * матрица читается построчно в обоих случаях.
+ */
+S21SparseMatrix::S21SparseMatrix(const S21Matrix& dense,
+                                 S21SparseFormat format)
+    : S21SparseMatrix(dense.GetRows(), dense.GetCols()) {
+  for (int i = 0; i < rows_; ++i) {
+    for (int j = 0; j < cols_; ++j) {
+      if (dense(i, j) != 0.0) {
+        indices_.push_back(j);
+        values_.push_back(dense(i, j));
+      }
+    }
+    offsets_[i + 1] = static_cast<int>(indices_.size());
+  }
+  if (format != format_) {
+    *this = ToFormat(format);
+  }
+}
+
+S21SparseMatrix S21SparseMatrix::FromTriplets(
+    int rows, int cols, const std::vector<S21Triplet>& triplets,
+    S21SparseFormat format) {
+  S21SparseMatrix res(rows, cols);
+  for (const S21Triplet& t : triplets) {
+    if (t.row < 0 || t.row >= rows || t.col < 0 || t.col >= cols) {
+      throw std::out_of_range("Incorrect input, index is out of range");
+    }
+    ++res.offsets_[t.row + 1];
+  }
+  for (int i = 0; i < rows; ++i) {
+    res.offsets_[i + 1] += res.offsets_[i];
+  }
+  // Раскладка по строкам, затем сортировка и слияние повторов в строке
+  std::vector<std::pair<int, double>> entries(triplets.size());
+  std::vector<int> cursor(res.offsets_.begin(), res.offsets_.end() - 1);
+  for (const S21Triplet& t : triplets) {
+    entries[cursor[t.row]++] = {t.col, t.value};
+  }
+  std::vector<int> offsets(rows + 1, 0);
+  for (int i = 0; i < rows; ++i) {
+    auto first = entries.begin() + res.offsets_[i];
+    auto last = entries.begin() + res.offsets_[i + 1];
+    std::sort(first, last, [](const auto& x, const auto& y) {
+      return x.first < y.first;
+    });
+    for (auto it = first; it != last;) {
+      const int col = it->first;
+      double sum = 0.0;
+      for (; it != last && it->first == col; ++it) {
+        sum += it->second;
+      }
+      if (sum != 0.0) {
+        res.indices_.push_back(col);
+        res.values_.push_back(sum);
+      }
+    }
+    offsets[i + 1] = static_cast<int>(res.indices_.size());
+  }
+  res.offsets_ = std::move(offsets);
+  return format == S21SparseFormat::kCsr ? res : res.ToFormat(format);
+}
+
+int S21SparseMatrix::GetMajor() const noexcept {
+  return format_ == S21SparseFormat::kCsr ? rows_ : cols_;
+}
+
+int S21SparseMatrix::GetMinor() const noexcept {
+  return format_ == S21SparseFormat::kCsr ? cols_ : rows_;
+}
+
+void S21SparseMatrix::CheckStructure() const {
+  const int major = GetMajor(), minor = GetMinor();
+  if (offsets_.size() != static_cast<std::size_t>(major) + 1 ||
+      offsets_[0] != 0 || indices_.size() != values_.size() ||
+      static_cast<std::size_t>(offsets_[major]) != indices_.size()) {
+    throw std::invalid_argument("Incorrect input, invalid sparse structure");
+  }
+  for (int i = 0; i < major; ++i) {
+    if (offsets_[i] > offsets_[i + 1]) {
+      throw std::invalid_argument("Incorrect input, invalid sparse structure");
+    }
+    for (int p = offsets_[i]; p < offsets_[i + 1]; ++p) {
+      if (indices_[p] < 0 || indices_[p] >= minor ||
+          (p > offsets_[i] && indices_[p] <= indices_[p - 1])) {
+        throw std::invalid_argument(
+            "Incorrect input, invalid sparse structure");
+      }
+    }
+  }
+}
+
+/**
+ * @brief Сравнение с допуском s21::ScalarTraits<double>::kEpsilon.
+ * @details Элемент, хранящийся только в одной из матриц, сравнивается
+ * с нулём. Матрицы разных форматов равны, если равны их элементы.
+ */
+bool S21SparseMatrix::EqMatrix(const S21SparseMatrix& other) const {
+  if (rows_ != other.rows_ || cols_ != other.cols_) {
+    return false;
+  }
+  if (format_ != other.format_) {
+    return EqMatrix(other.ToFormat(format_));
+  }
+  constexpr double eps = s21::ScalarTraits<double>::kEpsilon;
+  for (int i = 0; i < GetMajor(); ++i) {
+    int p = offsets_[i], q = other.offsets_[i];
+    const int p_end = offsets_[i + 1], q_end = other.offsets_[i + 1];
+    while (p < p_end || q < q_end) {
+      double diff = 0.0;
+      if (q == q_end || (p < p_end && indices_[p] < other.indices_[q])) {
+        diff = values_[p++];
+      } else if (p == p_end || other.indices_[q] < indices_[p]) {
+        diff = other.values_[q++];
+      } else {
+        diff = values_[p++] - other.values_[q++];
+      }
+      if (!(std::fabs(diff) <= eps)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief this + sign * other слиянием строк.
+ * @details Строки обеих матриц отсортированы, поэтому сумма строки
+ * считается одним проходом за O(nnz строк). Взаимно уничтожившиеся
+ * элементы из результата удаляются.
+ */
+void S21SparseMatrix::Merge(const S21SparseMatrix& other, double sign) {
+  if (rows_ != other.rows_ || cols_ != other.cols_) {
+    throw std::out_of_range(
+        "Incorrect input, matricex should have the same size");
+  }
+  if (other.format_ != format_) {
+    Merge(other.ToFormat(format_), sign);
+    return;
+  }
+  const int major = GetMajor();
+  std::vector<int> offsets(major + 1, 0), indices;
+  std::vector<double> values;
+  indices.reserve(indices_.size() + other.indices_.size());
+  values.reserve(indices_.size() + other.indices_.size());
+  for (int i = 0; i < major; ++i) {
+    int p = offsets_[i], q = other.offsets_[i];
+    const int p_end = offsets_[i + 1], q_end = other.offsets_[i + 1];
+    while (p < p_end || q < q_end) {
+      int index = 0;
+      double value = 0.0;
+      if (q == q_end || (p < p_end && indices_[p] < other.indices_[q])) {
+        index = indices_[p];
+        value = values_[p++];
+      } else if (p == p_end || other.indices_[q] < indices_[p]) {
+        index = other.indices_[q];
+        value = sign * other.values_[q++];
+      } else {
+        index = indices_[p];
+        value = values_[p++] + sign * other.values_[q++];
+      }
+      if (value != 0.0) {
+        indices.push_back(index);
+        values.push_back(value);
+      }
+    }
+    offsets[i + 1] = static_cast<int>(indices.size());
+  }
+  offsets_ = std::move(offsets);
+  indices_ = std::move(indices);
+  values_ = std::move(values);
+}
+
+void S21SparseMatrix::SumMatrix(const S21SparseMatrix& other) {
+  Merge(other, 1.0);
+}
+
+void S21SparseMatrix::SubMatrix(const S21SparseMatrix& other) {
+  Merge(other, -1.0);
+}
+
+void S21SparseMatrix::MulNumber(const double num) {
+  if (num == 0.0) {
+    *this = S21SparseMatrix(rows_, cols_, format_);
+    return;
+  }
+  s21::GetKernels().scale(values_.data(), num, values_.size());
+}
+
+/**
+ * @brief Умножение на разреженную матрицу.
+ * @details Для CSR считается CSR(A) * CSR(B). Для CSC используется
+ * (A * B)^T = B^T * A^T: массивы CSC матриц - это CSR транспонированных,
+ * так что тот же алгоритм даёт CSC результата без перестановок.
+ */
+void S21SparseMatrix::MulMatrix(const S21SparseMatrix& other) {
+  if (cols_ != other.rows_) {
+    throw std::invalid_argument(
+        "Incorrect input, matricex should have format M1.cols_ = M2.rows_");
+  }
+  if (other.format_ != format_) {
+    MulMatrix(other.ToFormat(format_));
+    return;
+  }
+  Compressed res =
+      format_ == S21SparseFormat::kCsr
+          ? Gustavson(rows_, other.cols_, offsets_, indices_, values_,
+                      other.offsets_, other.indices_, other.values_)
+          : Gustavson(other.cols_, rows_, other.offsets_, other.indices_,
+                      other.values_, offsets_, indices_, values_);
+  cols_ = other.cols_;
+  offsets_ = std::move(res.offsets);
+  indices_ = std::move(res.indices);
+  values_ = std::move(res.values);
+}
+
+/**
+ * @brief SpMV y = A * x.
+ * @details Для CSR каждая строка - скалярное произведение со своей
+ * частью x, строки считаются параллельно. Для CSC столбцы разбрасываются
+ * в y (y += x[j] * столбец j) в одном потоке.
+ */
+std::vector<double> S21SparseMatrix::MulVector(
+    const std::vector<double>& x) const {
+  if (x.size() != static_cast<std::size_t>(cols_)) {
+    throw std::invalid_argument(
+        "Incorrect input, matricex should have format M1.cols_ = M2.rows_");
+  }
+  std::vector<double> y(rows_, 0.0);
+  if (format_ == S21SparseFormat::kCsr) {
+    ForRows(rows_, values_.size(), [&](int first, int last) {
+      for (int i = first; i < last; ++i) {
+        double sum = 0.0;
+        for (int p = offsets_[i]; p < offsets_[i + 1]; ++p) {
+          sum += values_[p] * x[indices_[p]];
+        }
+        y[i] = sum;
+      }
+    });
+  } else {
+    for (int j = 0; j < cols_; ++j) {
+      for (int p = offsets_[j]; p < offsets_[j + 1]; ++p) {
+        y[indices_[p]] += values_[p] * x[j];
+      }
+    }
+  }
+  return y;
+}
+
+double S21SparseMatrix::operator()(int row, int col) const {
+  if (row < 0 || row >= rows_ || col < 0 || col >= cols_) {
+    throw std::out_of_range("Incorrect input, index is out of range");
+  }
+  const int major = format_ == S21SparseFormat::kCsr ? row : col;
+  const int minor = format_ == S21SparseFormat::kCsr ? col : row;
+  const auto first = indices_.begin() + offsets_[major];
+  const auto last = indices_.begin() + offsets_[major + 1];
+  const auto it = std::lower_bound(first, last, minor);
+  return it != last && *it == minor ? values_[it - indices_.begin()] : 0.0;
+}
+
+S21SparseMatrix& S21SparseMatrix::operator+=(const S21SparseMatrix& other) {
+  SumMatrix(other);
+  return *this;
+}
+
+S21SparseMatrix& S21SparseMatrix::operator-=(const S21SparseMatrix& other) {
+  SubMatrix(other);
+  return *this;
+}
+
+S21SparseMatrix& S21SparseMatrix::operator*=(const S21SparseMatrix& other) {
+  MulMatrix(other);
+  return *this;
+}
+
+S21SparseMatrix& S21SparseMatrix::operator*=(const double num) {
+  MulNumber(num);
+  return *this;
+}
+
+bool S21SparseMatrix::operator==(const S21SparseMatrix& other) const {
+  return EqMatrix(other);
+}
+
+S21Matrix S21SparseMatrix::ToDense() const {
+  S21Matrix res(rows_, cols_);
+  for (int i = 0; i < GetMajor(); ++i) {
+    for (int p = offsets_[i]; p < offsets_[i + 1]; ++p) {
+      if (format_ == S21SparseFormat::kCsr) {
+        res(i, indices_[p]) = values_[p];
+      } else {
+        res(indices_[p], i) = values_[p];
+      }
+    }
+  }
+  return res;
+}
+
+S21SparseMatrix S21SparseMatrix::ToFormat(S21SparseFormat format) const {
+  if (format == format_) {
+    return *this;
+  }
+  Compressed res =
+      Transposed(GetMajor(), GetMinor(), offsets_, indices_, values_);
+  S21SparseMatrix converted(rows_, cols_, format);
+  converted.offsets_ = std::move(res.offsets);
+  converted.indices_ = std::move(res.indices);
+  converted.values_ = std::move(res.values);
+  return converted;
+}
+
+S21SparseMatrix S21SparseMatrix::Transpose() const {
+  S21SparseMatrix res(*this);
+  std::swap(res.rows_, res.cols_);
+  res.format_ = format_ == S21SparseFormat::kCsr ? S21SparseFormat::kCsc
+                                                 : S21SparseFormat::kCsr;
+  return res;
+}
+
+// Accessors
+int S21SparseMatrix::GetRows() const noexcept { return rows_; }
+
+int S21SparseMatrix::GetCols() const noexcept { return cols_; }
+
+S21SparseFormat S21SparseMatrix::GetFormat() const noexcept {
+  return format_;
+}
+
+std::size_t S21SparseMatrix::GetNonZeros() const noexcept {
+  return values_.size();
+}
+
+const std::vector<int>& S21SparseMatrix::Offsets() const noexcept {
+  return offsets_;
+}
+
+const std::vector<int>& S21SparseMatrix::Indices() const noexcept {
+  return indices_;
+}
+
+const std::vector<double>& S21SparseMatrix::Values() const noexcept {
+  return values_;
+}
+
+S21SparseMatrix operator+(S21SparseMatrix a, const S21SparseMatrix& b) {
+  a.SumMatrix(b);
+  return a;
+}
+
+S21SparseMatrix operator-(S21SparseMatrix a, const S21SparseMatrix& b) {
+  a.SubMatrix(b);
+  return a;
+}
+
+S21SparseMatrix operator*(const S21SparseMatrix& a, const S21SparseMatrix& b) {
+  S21SparseMatrix res(a);
+  res.MulMatrix(b);
+  return res;
+}
+
+S21SparseMatrix operator*(S21SparseMatrix a, const double num) {
+  a.MulNumber(num);
+  return a;
+}
+
+S21SparseMatrix operator*(const double num, S21SparseMatrix a) {
+  a.MulNumber(num);
+  return a;
+}
+
+S21Matrix operator*(const S21SparseMatrix& a, const S21Matrix& b) {
+  return s21::Multiply(a, b);
+}
+
+S21Matrix operator*(const S21Matrix& a, const S21SparseMatrix& b) {
+  return s21::Multiply(a, b);
+}
+
+std::vector<double> operator*(const S21SparseMatrix& a,
+                              const std::vector<double>& x) {
+  return a.MulVector(x);
+}
+
+namespace s21 {
+/**
+ * @brief Разреженная на плотную: строка i результата - сумма строк b
+ * с весами из строки i матрицы a.
+ * @details O(nnz(a) * b.cols); строки b и результата читаются подряд.
+ * CSC матрица a перед умножением переводится в CSR.
+ */
+S21Matrix Multiply(const S21SparseMatrix& a, const S21Matrix& b) {
+  if (a.GetCols() != b.GetRows()) {
+    throw std::invalid_argument(
+        "Incorrect input, matricex should have format M1.cols_ = M2.rows_");
+  }
+  if (a.GetFormat() != S21SparseFormat::kCsr) {
+    return Multiply(a.ToFormat(S21SparseFormat::kCsr), b);
+  }
+  S21Matrix res(a.GetRows(), b.GetCols());
+  const int cols = b.GetCols();
+  const std::vector<int>& offsets = a.Offsets();
+  const std::vector<int>& indices = a.Indices();
+  const std::vector<double>& values = a.Values();
+  ForRows(a.GetRows(), a.GetNonZeros() * cols, [&](int first, int last) {
+    for (int i = first; i < last; ++i) {
+      double* dst = res.Data() + static_cast<std::size_t>(i) * cols;
+      for (int p = offsets[i]; p < offsets[i + 1]; ++p) {
+        const double* src =
+            b.Data() + static_cast<std::size_t>(indices[p]) * cols;
+        const double value = values[p];
+        for (int j = 0; j < cols; ++j) {
+          dst[j] += value * src[j];
+        }
+      }
+    }
+  });
+  return res;
+}
+
+/**
+ * @brief Плотная на разреженную: a(i, k) * строка k матрицы b для всех
+ * ненулевых a(i, k).
+ * @details O(a.rows * (a.cols + nnz(b))). CSC матрица b перед
+ * умножением переводится в CSR.
+ */
+S21Matrix Multiply(const S21Matrix& a, const S21SparseMatrix& b) {
+  if (a.GetCols() != b.GetRows()) {
+    throw std::invalid_argument(
+        "Incorrect input, matricex should have format M1.cols_ = M2.rows_");
+  }
+  if (b.GetFormat() != S21SparseFormat::kCsr) {
+    return Multiply(a, b.ToFormat(S21SparseFormat::kCsr));
+  }
+  S21Matrix res(a.GetRows(), b.GetCols());
+  const int cols = b.GetCols();
+  const std::vector<int>& offsets = b.Offsets();
+  const std::vector<int>& indices = b.Indices();
+  const std::vector<double>& values = b.Values();
+  const std::size_t work =
+      static_cast<std::size_t>(a.GetRows()) * b.GetNonZeros();
+  ForRows(a.GetRows(), work, [&](int first, int last) {
+    for (int i = first; i < last; ++i) {
+      double* dst = res.Data() + static_cast<std::size_t>(i) * cols;
+      for (int k = 0; k < a.GetCols(); ++k) {
+        const double scale = a(i, k);
+        if (scale == 0.0) {
+          continue;
+        }
+        for (int p = offsets[k]; p < offsets[k + 1]; ++p) {
+          dst[indices[p]] += scale * values[p];
+        }
+      }
+    }
+  });
+  return res;
+}
+}  // namespace s21
@@ -0,0 +1,117 @@
+#ifndef __S21SPARSEMATRIX_H__
+#define __S21SPARSEMATRIX_H__
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+/**
+ * @brief Порядок хранения разреженной матрицы.
+ * @details kCsr - по строкам (Compressed Sparse Row), kCsc - по столбцам
+ * (Compressed Sparse Column).
+ */
+enum class S21SparseFormat { kCsr, kCsc };
+
+// Ненулевой элемент (row, col) для сборки матрицы
+struct S21Triplet {
+  int row, col;
+  double value;
+};
+
+/**
+ * @brief Разреженная матрица double в формате CSR или CSC.
+ * @details
+ * Хранятся только ненулевые элементы. Для CSR строка i занимает позиции
+ * [offsets[i], offsets[i + 1]) массивов indices (номера столбцов по
+ * возрастанию) и values; для CSC то же по столбцам. Память и время всех
+ * операций растут с числом ненулевых элементов, а не с rows * cols:
+ * плотный буфер не создаётся, пока не вызван ToDense.
+ *
+ * Формат результата операции - формат левого операнда. Операнд другого
+ * формата перед операцией переводится за O(nnz + rows + cols).
+ */
+class S21SparseMatrix final {
+ private:
+  int rows_, cols_;
+  S21SparseFormat format_;
+  // offsets_.size() == GetMajor() + 1
+  std::vector<int> offsets_;
+  std::vector<int> indices_;
+  std::vector<double> values_;
+
+  int GetMajor() const noexcept;
+  int GetMinor() const noexcept;
+  void CheckStructure() const;
+  void Merge(const S21SparseMatrix& other, double sign);
+
+ public:
+  S21SparseMatrix();
+  // Нулевая матрица [rows x cols] без ненулевых элементов
+  explicit S21SparseMatrix(int rows, int cols,
+                           S21SparseFormat format = S21SparseFormat::kCsr);
+  /**
+   * @brief Матрица из готовых массивов формата.
+   * @details Структура проверяется: смещения неубывающие, индексы в
+   * пределах и строго возрастают внутри строки (столбца). Иначе
+   * выбрасывается std::invalid_argument.
+   */
+  S21SparseMatrix(int rows, int cols, S21SparseFormat format,
+                  std::vector<int> offsets, std::vector<int> indices,
+                  std::vector<double> values);
+  // Ненулевые элементы плотной матрицы
+  explicit S21SparseMatrix(const S21Matrix& dense,
+                           S21SparseFormat format = S21SparseFormat::kCsr);
+
+  // Сборка из списка элементов, повторы (row, col) складываются
+  static S21SparseMatrix FromTriplets(
+      int rows, int cols, const std::vector<S21Triplet>& triplets,
+      S21SparseFormat format = S21SparseFormat::kCsr);
+
+  bool EqMatrix(const S21SparseMatrix& other) const;
+  void SumMatrix(const S21SparseMatrix& other);
+  void SubMatrix(const S21SparseMatrix& other);
+  void MulNumber(const double num);
+  void MulMatrix(const S21SparseMatrix& other);
+  // SpMV: произведение на вектор-столбец x длины cols
+  std::vector<double> MulVector(const std::vector<double>& x) const;
+
+  // Элемент (row, col), поиск в строке (столбце) за O(log nnz строки)
+  double operator()(int row, int col) const;
+
+  S21SparseMatrix& operator+=(const S21SparseMatrix& other);
+  S21SparseMatrix& operator-=(const S21SparseMatrix& other);
+  S21SparseMatrix& operator*=(const S21SparseMatrix& other);
+  S21SparseMatrix& operator*=(const double num);
+  bool operator==(const S21SparseMatrix& other) const;
+
+  S21Matrix ToDense() const;
+  S21SparseMatrix ToFormat(S21SparseFormat format) const;
+  // Транспонирование без перестановки данных: CSR A - это CSC A^T
+  S21SparseMatrix Transpose() const;
+
+  int GetRows() const noexcept;
+  int GetCols() const noexcept;
+  S21SparseFormat GetFormat() const noexcept;
+  std::size_t GetNonZeros() const noexcept;
+  const std::vector<int>& Offsets() const noexcept;
+  const std::vector<int>& Indices() const noexcept;
+  const std::vector<double>& Values() const noexcept;
+};
+
+S21SparseMatrix operator+(S21SparseMatrix a, const S21SparseMatrix& b);
+S21SparseMatrix operator-(S21SparseMatrix a, const S21SparseMatrix& b);
+S21SparseMatrix operator*(const S21SparseMatrix& a, const S21SparseMatrix& b);
+S21SparseMatrix operator*(S21SparseMatrix a, const double num);
+S21SparseMatrix operator*(const double num, S21SparseMatrix a);
+S21Matrix operator*(const S21SparseMatrix& a, const S21Matrix& b);
+S21Matrix operator*(const S21Matrix& a, const S21SparseMatrix& b);
+std::vector<double> operator*(const S21SparseMatrix& a,
+                              const std::vector<double>& x);
+
+namespace s21 {
+// Произведения разреженной и плотной матриц, результат плотный
+S21Matrix Multiply(const S21SparseMatrix& a, const S21Matrix& b);
+S21Matrix Multiply(const S21Matrix& a, const S21SparseMatrix& b);
+}  // namespace s21
+
+#endif  //__S21SPARSEMATRIX_H__
@@ -0,0 +1,183 @@
+#include "s21_strassen.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "s21_gemm.h"
+
+namespace {
+int strassen_crossover = 0;
+
+// dst = x + sign * y для блоков [rows x cols]; dst может совпадать с x
+template <typename T>
+void Combine(int rows, int cols, const T* x, int ldx, const T* y, int ldy,
+             T sign, T* dst, int ldd) {
+  for (int i = 0; i < rows; ++i) {
+    const T* x_row = x + static_cast<std::ptrdiff_t>(i) * ldx;
+    const T* y_row = y + static_cast<std::ptrdiff_t>(i) * ldy;
+    T* dst_row = dst + static_cast<std::ptrdiff_t>(i) * ldd;
+    for (int j = 0; j < cols; ++j) {
+      dst_row[j] = x_row[j] + sign * y_row[j];
+    }
+  }
+}
+
+bool UseGemm(int m, int n, int k, int crossover) noexcept {
+  return std::min(std::min(m, n), k) < crossover;
+}
+
+/**
+ * @brief Рабочая память рекурсии в элементах.
+ * @details Уровень держит X [m/2 x k/2], Y [k/2 x n/2] и Z [m/2 x n/2],
+ * следующий уровень работает за ними, так что хватает суммы по цепочке
+ * вложенных вызовов.
+ */
+std::size_t WorkspaceSize(int m, int n, int k, int crossover) noexcept {
+  std::size_t size = 0;
+  while (!UseGemm(m, n, k, crossover)) {
+    m /= 2;
+    n /= 2;
+    k /= 2;
+    size += static_cast<std::size_t>(m) * k +
+            static_cast<std::size_t>(k) * n + static_cast<std::size_t>(m) * n;
+  }
+  return size;
+}
+
+/**
+ * @brief Один уровень Штрассена-Винограда, C = A * B.
+ * @details Порядок вычислений по Дугласу и др. (GEMMW): семь
+ * произведений P1..P7 складываются прямо в четвертях C, временные -
+ * только X, Y и Z, так что уровень не выделяет память.
+ *
+ *   S1 = A21 + A22   T1 = B12 - B11   P1 = A11 B11   P5 = S1 T1
+ *   S2 = S1 - A11    T2 = B22 - T1    P2 = A12 B21   P6 = S2 T2
+ *   S3 = A11 - A21   T3 = B22 - B12   P3 = S4 B22    P7 = S3 T3
+ *   S4 = A12 - S2    T4 = T2 - B21    P4 = A22 T4
+ *
+ *   C11 = P1 + P2    C12 = P1 + P6 + P5 + P3
+ *   C21 = P1 + P6 + P7 - P4    C22 = P1 + P6 + P7 + P5
+ */
+template <typename T>
+void Strassen(int m, int n, int k, const T* a, int lda, const T* b, int ldb,
+              T* c, int ldc, int crossover, T* work) {
+  if (UseGemm(m, n, k, crossover)) {
+    s21::Gemm(m, n, k, T(1), a, lda, 1, b, ldb, 1, T(0), c, ldc);
+    return;
+  }
+  const int m2 = m / 2, n2 = n / 2, k2 = k / 2;
+  const T* a11 = a;
+  const T* a12 = a + k2;
+  const T* a21 = a + static_cast<std::ptrdiff_t>(m2) * lda;
+  const T* a22 = a21 + k2;
+  const T* b11 = b;
+  const T* b12 = b + n2;
+  const T* b21 = b + static_cast<std::ptrdiff_t>(k2) * ldb;
+  const T* b22 = b21 + n2;
+  T* c11 = c;
+  T* c12 = c + n2;
+  T* c21 = c + static_cast<std::ptrdiff_t>(m2) * ldc;
+  T* c22 = c21 + n2;
+  T* x = work;
+  T* y = x + static_cast<std::size_t>(m2) * k2;
+  T* z = y + static_cast<std::size_t>(k2) * n2;
+  T* next = z + static_cast<std::size_t>(m2) * n2;
+  const T one(1), minus(-1);
+
+  Combine(m2, k2, a11, lda, a21, lda, minus, x, k2);  // S3
+  Combine(k2, n2, b22, ldb, b12, ldb, minus, y, n2);  // T3
+  Strassen(m2, n2, k2, x, k2, y, n2, c21, ldc, crossover, next);  // P7
+  Combine(m2, k2, a21, lda, a22, lda, one, x, k2);  // S1
+  Combine(k2, n2, b12, ldb, b11, ldb, minus, y, n2);  // T1
+  Strassen(m2, n2, k2, x, k2, y, n2, c22, ldc, crossover, next);  // P5
+  Combine(m2, k2, x, k2, a11, lda, minus, x, k2);  // S2
+  Combine(k2, n2, b22, ldb, y, n2, minus, y, n2);  // T2
+  Strassen(m2, n2, k2, x, k2, y, n2, c12, ldc, crossover, next);  // P6
+  Combine(m2, k2, a12, lda, x, k2, minus, x, k2);  // S4
+  Strassen(m2, n2, k2, x, k2, b22, ldb, c11, ldc, crossover, next);  // P3
+  Strassen(m2, n2, k2, a11, lda, b11, ldb, z, n2, crossover, next);  // P1
+  Combine(m2, n2, c12, ldc, z, n2, one, c12, ldc);    // P1 + P6
+  Combine(m2, n2, c21, ldc, c12, ldc, one, c21, ldc);  // + P7
+  Combine(m2, n2, c12, ldc, c22, ldc, one, c12, ldc);  // + P5
+  Combine(m2, n2, c22, ldc, c21, ldc, one, c22, ldc);  // C22
+  Combine(m2, n2, c12, ldc, c11, ldc, one, c12, ldc);  // C12
+  Combine(k2, n2, y, n2, b21, ldb, minus, y, n2);  // T4
+  Strassen(m2, n2, k2, a22, lda, y, n2, c11, ldc, crossover, next);  // P4
+  Combine(m2, n2, c21, ldc, c11, ldc, minus, c21, ldc);  // C21
+  Strassen(m2, n2, k2, a12, lda, b21, ldb, c11, ldc, crossover, next);  // P2
+  Combine(m2, n2, c11, ldc, z, n2, one, c11, ldc);  // C11
+
+  // Отщеплённые последние строка, столбец и слагаемое по k
+  if (k % 2 != 0) {
+    s21::Gemm(2 * m2, 2 * n2, 1, one, a + k - 1, lda, 1,
+              b + static_cast<std::ptrdiff_t>(k - 1) * ldb, ldb, 1, one, c,
+              ldc);
+  }
+  if (n % 2 != 0) {
+    s21::Gemm(m, 1, k, one, a, lda, 1, b + n - 1, ldb, 1, T(0), c + n - 1,
+              ldc);
+  }
+  if (m % 2 != 0) {
+    s21::Gemm(1, 2 * n2, k, one, a + static_cast<std::ptrdiff_t>(m - 1) * lda,
+              lda, 1, b, ldb, 1, T(0),
+              c + static_cast<std::ptrdiff_t>(m - 1) * ldc, ldc);
+  }
+}
+}  // namespace
+
+namespace s21 {
+template <typename T>
+void StrassenGemm(int m, int n, int k, const T* a, int lda, const T* b,
+                  int ldb, T* c, int ldc, int crossover) {
+  if (crossover < 2) {
+    throw std::invalid_argument("Strassen crossover must be at least 2");
+  }
+  if (m <= 0 || n <= 0) {
+    return;
+  }
+  std::vector<T> work(WorkspaceSize(m, n, k, crossover));
+  Strassen(m, n, k, a, lda, b, ldb, c, ldc, crossover, work.data());
+}
+
+template <typename T>
+S21MatrixT<T> MultiplyStrassen(const S21MatrixT<T>& a, const S21MatrixT<T>& b,
+                               int crossover) {
+  if (a.GetCols() != b.GetRows()) {
+    throw std::invalid_argument(
+        "Incorrect input, matricex should have format M1.cols_ = M2.rows_");
+  }
+  if (a.Data() == nullptr || b.Data() == nullptr || a.GetRows() < 1 ||
+      a.GetCols() < 1 || b.GetCols() < 1) {
+    throw std::out_of_range("Invalid matrix");
+  }
+  S21MatrixT<T> res(a.GetRows(), b.GetCols());
+  StrassenGemm(a.GetRows(), b.GetCols(), a.GetCols(), a.Data(),
+               a.GetStride(), b.Data(), b.GetStride(), res.Data(),
+               res.GetStride(), crossover);
+  return res;
+}
+
+int SetStrassenCrossover(int size) {
+  if (size < 0 || size == 1) {
+    throw std::invalid_argument("Strassen crossover must be 0 or at least 2");
+  }
+  return std::exchange(strassen_crossover, size);
+}
+
+int GetStrassenCrossover() noexcept { return strassen_crossover; }
+
+#define S21_STRASSEN_INSTANTIATE(T)                                       \
+  template void StrassenGemm(int m, int n, int k, const T* a, int lda,    \
+                             const T* b, int ldb, T* c, int ldc,          \
+                             int crossover);                              \
+  template S21MatrixT<T> MultiplyStrassen(const S21MatrixT<T>& a,         \
+                                          const S21MatrixT<T>& b,         \
+                                          int crossover);
+
+S21_STRASSEN_INSTANTIATE(float)
+S21_STRASSEN_INSTANTIATE(double)
+S21_STRASSEN_INSTANTIATE(long double)
+#undef S21_STRASSEN_INSTANTIATE
+}  // namespace s21
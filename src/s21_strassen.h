@@ -0,0 +1,61 @@
+#ifndef __S21STRASSEN_H__
+#define __S21STRASSEN_H__
+
+#include <cstddef>
+
+#include "s21_matrix_oop.h"
+
+namespace s21 {
+/**
+ * @brief Размер по умолчанию, ниже которого рекурсия Штрассена
+ * переходит на Gemm.
+ * @details Подобран по make bench (BM_MulMatrixStrassen против
+ * BM_MulMatrix): на меньших блоках выигрыш одного умножения из восьми
+ * съедают лишние сложения и проходы по памяти.
+ */
+constexpr int kStrassenCrossover = 256;
+
+/**
+ * @brief Умножение C = A * B по схеме Штрассена-Винограда.
+ * @details
+ * Каждый уровень рекурсии заменяет 8 умножений блоков половинного
+ * размера на 7 ценой 15 сложений, так что сложность - O(n^2.81).
+ * Рекурсия идёт, пока все размеры не меньше crossover, дальше блоки
+ * умножаются Gemm. Нечётная строка или столбец отщепляется и
+ * досчитывается Gemm (dynamic peeling), поэтому размеры любые.
+ * Рабочая память всех уровней выделяется одним буфером до начала
+ * рекурсии.
+ *
+ * Точность. Классическое умножение даёт поэлементную оценку
+ * |C - C'| <= k * u * |A| * |B|. У Штрассена оценка только нормовая,
+ * ||C - C'|| <= c * k^log2(12) * u * ||A|| * ||B||, и растёт примерно
+ * втрое с каждым уровнем: малые элементы C при сильно различающихся по
+ * величине элементах A и B теряют относительную точность. Для матриц
+ * одного масштаба разница - несколько последних разрядов.
+ *
+ * Строки A, B и C идут с шагами lda, ldb, ldc, элементы в строке - подряд.
+ * Определено для float, double и long double.
+ * @param crossover размер, ниже которого используется Gemm (не меньше 2)
+ */
+template <typename T>
+void StrassenGemm(int m, int n, int k, const T* a, int lda, const T* b,
+                  int ldb, T* c, int ldc, int crossover = kStrassenCrossover);
+
+// Произведение a * b в новую матрицу по схеме Штрассена-Винограда
+template <typename T>
+S21MatrixT<T> MultiplyStrassen(const S21MatrixT<T>& a, const S21MatrixT<T>& b,
+                               int crossover = kStrassenCrossover);
+
+/**
+ * @brief Включение Штрассена в MulMatrix, operator* и s21::Multiply.
+ * @details При size > 0 произведения вещественных матриц, у которых все
+ * размеры не меньше size, считаются StrassenGemm с crossover = size.
+ * 0 (по умолчанию) - только классическое умножение. Менять значение
+ * можно только когда в других потоках не выполняются операции над
+ * матрицами. Возвращает прежнее значение.
+ */
+int SetStrassenCrossover(int size);
+int GetStrassenCrossover() noexcept;
+}  // namespace s21
+
+#endif  //__S21STRASSEN_H__
@@ -0,0 +1,206 @@
+#include "s21_thread_pool.h"
+
+#include <exception>
+#include <stdexcept>
+
+namespace {
+// Мьютекс нужен только для создания и замены пула: Global() читает
+// указатель без блокировки, а пулом владеет global_pool_owner
+std::mutex global_pool_mutex;
+std::unique_ptr<s21::ThreadPool> global_pool_owner;
+std::atomic<s21::ThreadPool*> global_pool{nullptr};
+
+int DefaultThreadCount() noexcept {
+  int threads = static_cast<int>(std::thread::hardware_concurrency());
+  return threads > 0 ? threads : 1;
+}
+
+/**
+ * @brief Общее состояние одного вызова ParallelFor.
+ * @details Хранит счётчик незавершённых задач и первое пойманное
+ * исключение, которое затем пробрасывается в вызывающий поток.
+ */
+struct ForState {
+  std::atomic<int> remaining;
+  std::mutex mutex;
+  std::condition_variable done;
+  std::exception_ptr error;
+};
+}  // namespace
+
+namespace s21 {
+/**
+ * @brief Конструктор пула.
+ * @param threads общее число потоков вместе с вызывающим, рабочих потоков
+ * создаётся threads - 1
+ */
+ThreadPool::ThreadPool(int threads)
+    : queued_(0), next_queue_(0), stop_(false) {
+  if (threads < 1) {
+    throw std::invalid_argument("Thread count must be greater than 0");
+  }
+  for (int i = 0; i < threads - 1; ++i) {
+    queues_.push_back(std::make_unique<Queue>());
+  }
+  for (std::size_t i = 0; i < queues_.size(); ++i) {
+    workers_.emplace_back(&ThreadPool::WorkerLoop, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+int ThreadPool::GetThreadCount() const noexcept {
+  return static_cast<int>(workers_.size()) + 1;
+}
+
+/**
+ * @brief Выполняет body(0) ... body(count - 1) и дожидается завершения.
+ * @details Без рабочих потоков или для одной задачи цикл выполняется
+ * в вызывающем потоке. Первое исключение из задач пробрасывается наружу
+ * после завершения остальных задач.
+ */
+void ThreadPool::ParallelFor(int count,
+                             const std::function<void(int)>& body) {
+  if (count <= 0) {
+    return;
+  }
+  if (workers_.empty() || count == 1) {
+    for (int i = 0; i < count; ++i) {
+      body(i);
+    }
+    return;
+  }
+  ForState state;
+  state.remaining = count;
+  for (int i = 0; i < count; ++i) {
+    auto task = [&state, &body, i] {
+      try {
+        body(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (!state.error) {
+          state.error = std::current_exception();
+        }
+      }
+      // Счётчик меняется под мьютексом: после его освобождения задача
+      // больше не обращается к state, и вызывающий поток может его удалить
+      std::lock_guard<std::mutex> lock(state.mutex);
+      if (--state.remaining == 0) {
+        state.done.notify_all();
+      }
+    };
+    Queue& queue = *queues_[next_queue_++ % queues_.size()];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(std::move(task));
+  }
+  {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    queued_ += count;
+  }
+  wake_.notify_all();
+
+  // Пока есть что украсть, вызывающий поток работает сам. Когда очереди
+  // пусты, все оставшиеся задачи уже выполняются, и он ждёт сигнала
+  // последней из них. Вложенные ParallelFor этих задач выполняют
+  // вызвавшие их потоки и остальные рабочие, так что ожидание без
+  // опроса очередей не блокирует пул.
+  while (state.remaining > 0) {
+    if (!TryRunOne(next_queue_ % queues_.size())) {
+      std::unique_lock<std::mutex> lock(state.mutex);
+      state.done.wait(lock, [&state] { return state.remaining == 0; });
+    }
+  }
+  std::lock_guard<std::mutex> lock(state.mutex);
+  if (state.error) {
+    std::rethrow_exception(state.error);
+  }
+}
+
+/**
+ * @brief Берёт одну задачу и выполняет её.
+ * @details Очередь start обслуживается с головы, остальные - с хвоста
+ * (кража). Возвращает false, если все очереди пусты.
+ */
+bool ThreadPool::TryRunOne(std::size_t start) {
+  std::function<void()> task;
+  for (std::size_t i = 0; i < queues_.size() && !task; ++i) {
+    Queue& queue = *queues_[(start + i) % queues_.size()];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      if (i == 0) {
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+      } else {
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+      }
+    }
+  }
+  if (task) {
+    --queued_;
+    task();
+  }
+  return static_cast<bool>(task);
+}
+
+void ThreadPool::WorkerLoop(std::size_t index) {
+  for (;;) {
+    if (TryRunOne(index)) {
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    wake_.wait(lock, [this] { return stop_ || queued_ > 0; });
+    if (stop_) {
+      return;
+    }
+  }
+}
+
+/**
+ * @brief Общий пул библиотеки.
+ * @details Вызывается на каждый Gemm и шаг LU, поэтому готовый пул
+ * читается одной загрузкой с acquire, без мьютекса. Блокировка берётся
+ * только при первом вызове, когда пул создаётся.
+ */
+ThreadPool& ThreadPool::Global() {
+  ThreadPool* pool = global_pool.load(std::memory_order_acquire);
+  if (pool == nullptr) {
+    std::lock_guard<std::mutex> lock(global_pool_mutex);
+    pool = global_pool.load(std::memory_order_relaxed);
+    if (pool == nullptr) {
+      global_pool_owner = std::make_unique<ThreadPool>(DefaultThreadCount());
+      pool = global_pool_owner.get();
+      global_pool.store(pool, std::memory_order_release);
+    }
+  }
+  return *pool;
+}
+
+void SetNumThreads(int threads) {
+  if (threads < 1) {
+    throw std::invalid_argument("Thread count must be greater than 0");
+  }
+  std::lock_guard<std::mutex> lock(global_pool_mutex);
+  ThreadPool* pool = global_pool.load(std::memory_order_relaxed);
+  if (pool == nullptr || pool->GetThreadCount() != threads) {
+    // Старый пул никто не использует - это условие SetNumThreads
+    global_pool.store(nullptr, std::memory_order_relaxed);
+    global_pool_owner.reset();
+    global_pool_owner = std::make_unique<ThreadPool>(threads);
+    global_pool.store(global_pool_owner.get(), std::memory_order_release);
+  }
+}
+
+int GetNumThreads() {
+  return ThreadPool::Global().GetThreadCount();
+}
+}  // namespace s21
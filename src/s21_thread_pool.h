@@ -0,0 +1,62 @@
+#ifndef __S21THREADPOOL_H__
+#define __S21THREADPOOL_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace s21 {
+/**
+ * @brief Пул потоков с кражей задач (work stealing).
+ * @details
+ * У каждого рабочего потока своя очередь: владелец берёт задачи с головы,
+ * остальные потоки при простое крадут с хвоста. Поток, вызвавший
+ * ParallelFor, не простаивает, а тоже выполняет задачи, поэтому вложенные
+ * вызовы ParallelFor из задачи не приводят к взаимной блокировке.
+ */
+class ThreadPool final {
+ public:
+  explicit ThreadPool(int threads);
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ~ThreadPool();
+
+  int GetThreadCount() const noexcept;
+  void ParallelFor(int count, const std::function<void(int)>& body);
+
+  static ThreadPool& Global();
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  bool TryRunOne(std::size_t start);
+  void WorkerLoop(std::size_t index);
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::vector<std::thread> workers_;
+  std::mutex wake_mutex_;
+  std::condition_variable wake_;
+  std::atomic<int> queued_;
+  std::atomic<std::size_t> next_queue_;
+  bool stop_;
+};
+
+/**
+ * @brief Число потоков, которыми библиотека выполняет тяжёлые операции.
+ * @details Значение 1 отключает параллельный режим. По умолчанию равно
+ * std::thread::hardware_concurrency(). Менять значение можно только когда
+ * в других потоках не выполняются операции над матрицами.
+ */
+void SetNumThreads(int threads);
+int GetNumThreads();
+}  // namespace s21
+
+#endif  //__S21THREADPOOL_H__
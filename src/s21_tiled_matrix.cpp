@@ -0,0 +1,572 @@
+#include "s21_tiled_matrix.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <future>
+#include <limits>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "s21_gemm.h"
+#include "s21_simd.h"
+#include "s21_thread_pool.h"
+#include "s21_transpose.h"
+
+namespace {
+// Плитки начинаются с границы страницы
+constexpr std::size_t kTiledDataOffset = 4096;
+
+[[noreturn]] void ThrowErrno(const std::string& what) {
+  throw std::system_error(errno, std::generic_category(), what);
+}
+
+void ReadAt(int fd, void* dst, std::size_t bytes, std::size_t offset) {
+  char* p = static_cast<char*>(dst);
+  while (bytes > 0) {
+    const ssize_t done = ::pread(fd, p, bytes, static_cast<off_t>(offset));
+    if (done < 0 && errno == EINTR) {
+      continue;
+    }
+    if (done < 0) {
+      ThrowErrno("Cannot read tiled matrix file");
+    }
+    if (done == 0) {
+      throw std::runtime_error("Matrix file is truncated");
+    }
+    p += done;
+    bytes -= static_cast<std::size_t>(done);
+    offset += static_cast<std::size_t>(done);
+  }
+}
+
+void WriteAt(int fd, const void* src, std::size_t bytes, std::size_t offset) {
+  const char* p = static_cast<const char*>(src);
+  while (bytes > 0) {
+    const ssize_t done = ::pwrite(fd, p, bytes, static_cast<off_t>(offset));
+    if (done < 0 && errno == EINTR) {
+      continue;
+    }
+    if (done < 0) {
+      ThrowErrno("Cannot write tiled matrix file");
+    }
+    p += done;
+    bytes -= static_cast<std::size_t>(done);
+    offset += static_cast<std::size_t>(done);
+  }
+}
+
+/**
+ * @brief Конвейер из steps шагов на двух наборах буферов.
+ * @details load(step, set) читает данные шага в набор set, compute(step,
+ * set) их обрабатывает. Пока compute считает шаг на наборе step % 2,
+ * load следующего шага идёт в отдельном потоке в другой набор. Ошибка
+ * чтения всплывает из get(), а при ошибке в compute деструктор future
+ * дожидается чтения, так что буферы не освобождаются под ним.
+ */
+template <typename Load, typename Compute>
+void Pipeline(int steps, const Load& load, const Compute& compute) {
+  if (steps > 0) {
+    load(0, 0);
+  }
+  for (int step = 0; step < steps; ++step) {
+    std::future<void> next;
+    if (step + 1 < steps) {
+      next = std::async(std::launch::async, load, step + 1, (step + 1) % 2);
+    }
+    compute(step, step % 2);
+    if (next.valid()) {
+      next.get();
+    }
+  }
+}
+
+/**
+ * @brief Помещается ли файл плиток матрицы [rows x cols] в off_t.
+ * @details Как CheckHeader в s21_matrix_io.cpp: иначе TileOffset
+ * переполнится, проверка длины файла пропустит испорченный заголовок, а
+ * чтение пойдёт по неверному смещению. Число плиток ещё и не больше
+ * INT_MAX - операции нумеруют плитки int. rows, cols и tile - от 1 до
+ * INT_MAX, поэтому промежуточные произведения помещаются в uint64_t.
+ */
+bool FitsInFile(std::uint64_t rows, std::uint64_t cols, std::uint64_t tile,
+                std::size_t element_size) {
+  constexpr std::uint64_t kLimit = std::numeric_limits<off_t>::max();
+  const std::uint64_t tiles =
+      ((rows + tile - 1) / tile) * ((cols + tile - 1) / tile);
+  const std::uint64_t elements = (kLimit - kTiledDataOffset) / element_size;
+  return tiles <= INT_MAX && tile * tile <= elements &&
+         tiles <= elements / (tile * tile);
+}
+
+/**
+ * @brief Результат операции не должен затирать её операнды.
+ * @details Новый файл открывается с O_TRUNC, поэтому path, указывающий на
+ * файл операнда (в том числе другим путём или жёсткой ссылкой), обнулил
+ * бы его до чтения. Файлы сравниваются по устройству и inode.
+ */
+void CheckOutputPath(const std::string& path, int lhs_fd, int rhs_fd) {
+  struct stat output;
+  if (::stat(path.c_str(), &output) != 0) {
+    return;
+  }
+  for (int fd : {lhs_fd, rhs_fd}) {
+    struct stat input;
+    if (fd >= 0 && ::fstat(fd, &input) == 0 &&
+        input.st_dev == output.st_dev && input.st_ino == output.st_ino) {
+      throw std::invalid_argument(
+          "Incorrect input, output file is an operand of the operation");
+    }
+  }
+}
+
+// count буферов по одной плитке
+template <typename T>
+std::vector<S21MatrixT<T>> MakeTiles(std::size_t count, int tile) {
+  std::vector<S21MatrixT<T>> tiles;
+  tiles.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    tiles.emplace_back(tile, tile);
+  }
+  return tiles;
+}
+}  // namespace
+
+template <typename T>
+S21TiledMatrixT<T>::S21TiledMatrixT() noexcept
+    : fd_(-1), rows_(0), cols_(0), tile_(0) {}
+
+template <typename T>
+S21TiledMatrixT<T>::S21TiledMatrixT(const std::string& path, int rows,
+                                    int cols, int tile)
+    : S21TiledMatrixT() {
+  if (rows < 1 || cols < 1) {
+    throw std::length_error("Matrix size must be greater than 0");
+  }
+  if (tile < 1) {
+    throw std::invalid_argument("Tile size must be greater than 0");
+  }
+  if (!FitsInFile(rows, cols, tile, sizeof(T))) {
+    throw std::length_error("Matrix is too large for a tiled file");
+  }
+  fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd_ < 0) {
+    ThrowErrno("Cannot open matrix file " + path);
+  }
+  rows_ = rows;
+  cols_ = cols;
+  tile_ = tile;
+  path_ = path;
+  try {
+    s21::MatrixFileHeader header{};
+    std::memcpy(header.magic, s21::kTiledFileMagic, sizeof(header.magic));
+    header.version = s21::kMatrixFileVersion;
+    header.byte_order = s21::kByteOrderMark;
+    header.dtype = s21::MatrixFileType<T>::kCode;
+    header.element_size = sizeof(T);
+    header.rows = rows;
+    header.cols = cols;
+    header.stride = tile;
+    header.data_offset = kTiledDataOffset;
+    WriteAt(fd_, &header, sizeof(header), 0);
+    // Плитки - дыра в файле, место выделяется при записи
+    if (::ftruncate(fd_, static_cast<off_t>(
+                             TileOffset(GetTileRows(), 0))) != 0) {
+      ThrowErrno("Cannot resize matrix file " + path);
+    }
+  } catch (...) {
+    Close();
+    throw;
+  }
+}
+
+template <typename T>
+S21TiledMatrixT<T>::S21TiledMatrixT(const std::string& path)
+    : S21TiledMatrixT() {
+  fd_ = ::open(path.c_str(), O_RDWR);
+  if (fd_ < 0) {
+    ThrowErrno("Cannot open matrix file " + path);
+  }
+  path_ = path;
+  try {
+    s21::MatrixFileHeader header;
+    ReadAt(fd_, &header, sizeof(header), 0);
+    if (std::memcmp(header.magic, s21::kTiledFileMagic,
+                    sizeof(header.magic)) != 0 ||
+        header.version != s21::kMatrixFileVersion) {
+      throw std::invalid_argument("Incorrect input, file is not a matrix");
+    }
+    if (header.byte_order != s21::kByteOrderMark) {
+      throw std::invalid_argument(
+          "Incorrect input, matrix file has another byte order");
+    }
+    if (header.dtype != s21::MatrixFileType<T>::kCode ||
+        header.element_size != sizeof(T)) {
+      throw std::invalid_argument(
+          "Incorrect input, matrix file has another element type");
+    }
+    if (header.rows < 1 || header.cols < 1 || header.stride < 1 ||
+        header.rows > INT_MAX || header.cols > INT_MAX ||
+        header.stride > INT_MAX || header.data_offset != kTiledDataOffset ||
+        !FitsInFile(header.rows, header.cols, header.stride, sizeof(T))) {
+      throw std::runtime_error("Matrix file is corrupted");
+    }
+    rows_ = static_cast<int>(header.rows);
+    cols_ = static_cast<int>(header.cols);
+    tile_ = static_cast<int>(header.stride);
+    struct stat info;
+    if (::fstat(fd_, &info) != 0) {
+      ThrowErrno("Cannot stat matrix file " + path);
+    }
+    if (static_cast<std::size_t>(info.st_size) <
+        TileOffset(GetTileRows(), 0)) {
+      throw std::runtime_error("Matrix file is truncated");
+    }
+  } catch (...) {
+    Close();
+    throw;
+  }
+}
+
+template <typename T>
+S21TiledMatrixT<T>::S21TiledMatrixT(S21TiledMatrixT&& other) noexcept
+    : S21TiledMatrixT() {
+  *this = std::move(other);
+}
+
+template <typename T>
+S21TiledMatrixT<T>& S21TiledMatrixT<T>::operator=(
+    S21TiledMatrixT&& other) noexcept {
+  if (this != &other) {
+    Close();
+    fd_ = std::exchange(other.fd_, -1);
+    rows_ = std::exchange(other.rows_, 0);
+    cols_ = std::exchange(other.cols_, 0);
+    tile_ = std::exchange(other.tile_, 0);
+    path_ = std::move(other.path_);
+  }
+  return *this;
+}
+
+template <typename T>
+S21TiledMatrixT<T>::~S21TiledMatrixT() {
+  Close();
+}
+
+template <typename T>
+void S21TiledMatrixT<T>::Close() noexcept {
+  if (fd_ >= 0) {
+    ::close(fd_);
+  }
+  fd_ = -1;
+  rows_ = cols_ = tile_ = 0;
+}
+
+template <typename T>
+std::size_t S21TiledMatrixT<T>::TileOffset(int tile_row,
+                                           int tile_col) const noexcept {
+  const std::size_t index =
+      static_cast<std::size_t>(tile_row) * GetTileCols() + tile_col;
+  return kTiledDataOffset +
+         index * static_cast<std::size_t>(tile_) * tile_ * sizeof(T);
+}
+
+template <typename T>
+void S21TiledMatrixT<T>::CheckTile(int tile_row, int tile_col) const {
+  if (fd_ < 0) {
+    throw std::out_of_range("Invalid matrix");
+  }
+  if (tile_row < 0 || tile_col < 0 || tile_row >= GetTileRows() ||
+      tile_col >= GetTileCols()) {
+    throw std::out_of_range("Incorrect input, index is out of range");
+  }
+}
+
+template <typename T>
+void S21TiledMatrixT<T>::CheckBudget(std::size_t tiles,
+                                     std::size_t budget) const {
+  if (fd_ < 0) {
+    throw std::out_of_range("Invalid matrix");
+  }
+  if (budget / (static_cast<std::size_t>(tile_) * tile_ * sizeof(T)) <
+      tiles) {
+    throw std::invalid_argument("Memory budget is too small for tile size");
+  }
+}
+
+template <typename T>
+void S21TiledMatrixT<T>::ReadTile(int tile_row, int tile_col, T* dst) const {
+  CheckTile(tile_row, tile_col);
+  ReadAt(fd_, dst, static_cast<std::size_t>(tile_) * tile_ * sizeof(T),
+         TileOffset(tile_row, tile_col));
+}
+
+template <typename T>
+void S21TiledMatrixT<T>::WriteTile(int tile_row, int tile_col, const T* src) {
+  CheckTile(tile_row, tile_col);
+  WriteAt(fd_, src, static_cast<std::size_t>(tile_) * tile_ * sizeof(T),
+          TileOffset(tile_row, tile_col));
+}
+
+/**
+ * @brief Запись блока по плиткам.
+ * @details Плитка, которую блок покрывает не целиком, сначала читается,
+ * остальные только пишутся. В памяти одна плитка.
+ */
+template <typename T>
+void S21TiledMatrixT<T>::WriteBlock(int row, int col, int rows, int cols,
+                                    const T* src, std::size_t stride) {
+  if (fd_ < 0) {
+    throw std::out_of_range("Invalid matrix");
+  }
+  if (row < 0 || col < 0 || rows < 1 || cols < 1 || rows > rows_ - row ||
+      cols > cols_ - col) {
+    throw std::out_of_range("Incorrect input, index is out of range");
+  }
+  S21MatrixT<T> buffer(tile_, tile_);
+  for (int ti = row / tile_; ti * tile_ < row + rows; ++ti) {
+    const int i0 = std::max(row, ti * tile_);
+    const int i1 = std::min(row + rows, (ti + 1) * tile_);
+    for (int tj = col / tile_; tj * tile_ < col + cols; ++tj) {
+      const int j0 = std::max(col, tj * tile_);
+      const int j1 = std::min(col + cols, (tj + 1) * tile_);
+      // В крайней плитке старое содержимое - хотя бы нули дополнения
+      if (i1 - i0 < tile_ || j1 - j0 < tile_) {
+        ReadTile(ti, tj, buffer.Data());
+      }
+      for (int i = i0; i < i1; ++i) {
+        std::copy_n(src + static_cast<std::size_t>(i - row) * stride +
+                        (j0 - col),
+                    j1 - j0,
+                    buffer.Data() +
+                        static_cast<std::size_t>(i - ti * tile_) * tile_ +
+                        (j0 - tj * tile_));
+      }
+      WriteTile(ti, tj, buffer.Data());
+    }
+  }
+}
+
+template <typename T>
+S21TiledMatrixT<T> S21TiledMatrixT<T>::Import(
+    const S21MappedMatrixT<T>& matrix, const std::string& path, int tile) {
+  S21TiledMatrixT res(path, matrix.GetRows(), matrix.GetCols(), tile);
+  res.WriteBlock(0, 0, res.rows_, res.cols_, matrix.Data(),
+                 matrix.GetStride());
+  return res;
+}
+
+template <typename T>
+void S21TiledMatrixT<T>::SetBlock(int row, int col,
+                                  const S21MatrixT<T>& block) {
+  WriteBlock(row, col, block.GetRows(), block.GetCols(), block.Data(),
+             block.GetStride());
+}
+
+template <typename T>
+S21MatrixT<T> S21TiledMatrixT<T>::GetBlock(int row, int col, int rows,
+                                           int cols) const {
+  if (fd_ < 0) {
+    throw std::out_of_range("Invalid matrix");
+  }
+  if (row < 0 || col < 0 || rows < 1 || cols < 1 || rows > rows_ - row ||
+      cols > cols_ - col) {
+    throw std::out_of_range("Incorrect input, index is out of range");
+  }
+  S21MatrixT<T> res(rows, cols);
+  S21MatrixT<T> buffer(tile_, tile_);
+  for (int ti = row / tile_; ti * tile_ < row + rows; ++ti) {
+    const int i0 = std::max(row, ti * tile_);
+    const int i1 = std::min(row + rows, (ti + 1) * tile_);
+    for (int tj = col / tile_; tj * tile_ < col + cols; ++tj) {
+      const int j0 = std::max(col, tj * tile_);
+      const int j1 = std::min(col + cols, (tj + 1) * tile_);
+      ReadTile(ti, tj, buffer.Data());
+      for (int i = i0; i < i1; ++i) {
+        std::copy_n(buffer.Data() +
+                        static_cast<std::size_t>(i - ti * tile_) * tile_ +
+                        (j0 - tj * tile_),
+                    j1 - j0,
+                    res.Data() + static_cast<std::size_t>(i - row) * cols +
+                        (j0 - col));
+      }
+    }
+  }
+  return res;
+}
+
+template <typename T>
+S21MatrixT<T> S21TiledMatrixT<T>::ToMatrix() const {
+  return GetBlock(0, 0, rows_, cols_);
+}
+
+template <typename T>
+void S21TiledMatrixT<T>::SumMatrix(const S21TiledMatrixT& other,
+                                   std::size_t memory_budget) {
+  if (rows_ != other.rows_ || cols_ != other.cols_) {
+    throw std::out_of_range(
+        "Incorrect input, matricex should have the same size");
+  }
+  if (tile_ != other.tile_) {
+    throw std::invalid_argument(
+        "Incorrect input, matrices should have the same tile size");
+  }
+  // Два набора по group плиток из this и из other
+  CheckBudget(4, memory_budget);
+  const int tile_cols = GetTileCols();
+  const int count = GetTileRows() * tile_cols;
+  const int group = static_cast<int>(std::min<std::size_t>(
+      count, memory_budget /
+                 (4 * static_cast<std::size_t>(tile_) * tile_ * sizeof(T))));
+  const std::size_t tile_size = static_cast<std::size_t>(tile_) * tile_;
+  std::vector<S21MatrixT<T>> lhs[2] = {MakeTiles<T>(group, tile_),
+                                       MakeTiles<T>(group, tile_)};
+  std::vector<S21MatrixT<T>> rhs[2] = {MakeTiles<T>(group, tile_),
+                                       MakeTiles<T>(group, tile_)};
+  const auto add = s21::GetKernels<T>().add;
+  Pipeline(
+      (count + group - 1) / group,
+      [&](int step, int set) {
+        for (int i = 0, index = step * group; i < group && index < count;
+             ++i, ++index) {
+          ReadTile(index / tile_cols, index % tile_cols, lhs[set][i].Data());
+          other.ReadTile(index / tile_cols, index % tile_cols,
+                         rhs[set][i].Data());
+        }
+      },
+      [&](int step, int set) {
+        for (int i = 0, index = step * group; i < group && index < count;
+             ++i, ++index) {
+          add(lhs[set][i].Data(), rhs[set][i].Data(), tile_size);
+          WriteTile(index / tile_cols, index % tile_cols, lhs[set][i].Data());
+        }
+      });
+}
+
+template <typename T>
+S21TiledMatrixT<T> S21TiledMatrixT<T>::MulMatrix(
+    const S21TiledMatrixT& other, const std::string& path,
+    std::size_t memory_budget) const {
+  if (cols_ != other.rows_) {
+    throw std::invalid_argument(
+        "Incorrect input, matricex should have format M1.cols_ = M2.rows_");
+  }
+  if (tile_ != other.tile_) {
+    throw std::invalid_argument(
+        "Incorrect input, matrices should have the same tile size");
+  }
+  // Блок 1 x 1: плитка C и два набора по плитке A и B
+  CheckBudget(5, memory_budget);
+  const std::size_t budget_tiles =
+      memory_budget / (static_cast<std::size_t>(tile_) * tile_ * sizeof(T));
+  std::size_t side = 1;
+  while ((side + 1) * (side + 1) + 4 * (side + 1) <= budget_tiles) {
+    ++side;
+  }
+  const int tile_rows = GetTileRows(), tile_cols = other.GetTileCols();
+  const int depth = GetTileCols();
+  const int block_rows = static_cast<int>(std::min<std::size_t>(side,
+                                                                tile_rows));
+  const int block_cols = static_cast<int>(std::min<std::size_t>(side,
+                                                                tile_cols));
+  const int blocks_per_row = (tile_cols + block_cols - 1) / block_cols;
+  const int blocks =
+      (tile_rows + block_rows - 1) / block_rows * blocks_per_row;
+
+  CheckOutputPath(path, fd_, other.fd_);
+  S21TiledMatrixT res(path, rows_, other.cols_, tile_);
+  std::vector<S21MatrixT<T>> a[2] = {MakeTiles<T>(block_rows, tile_),
+                                     MakeTiles<T>(block_rows, tile_)};
+  std::vector<S21MatrixT<T>> b[2] = {MakeTiles<T>(block_cols, tile_),
+                                     MakeTiles<T>(block_cols, tile_)};
+  std::vector<S21MatrixT<T>> c = MakeTiles<T>(
+      static_cast<std::size_t>(block_rows) * block_cols, tile_);
+  const std::size_t tile_size = static_cast<std::size_t>(tile_) * tile_;
+  // Шаг - один слой k для одного блока C; у блока у края плиток меньше
+  auto block_shape = [&](int step, int& row0, int& col0, int& rows,
+                         int& cols) {
+    const int block = step / depth;
+    row0 = block / blocks_per_row * block_rows;
+    col0 = block % blocks_per_row * block_cols;
+    rows = std::min(block_rows, tile_rows - row0);
+    cols = std::min(block_cols, tile_cols - col0);
+  };
+  Pipeline(
+      blocks * depth,
+      [&](int step, int set) {
+        int row0, col0, rows, cols;
+        block_shape(step, row0, col0, rows, cols);
+        const int kk = step % depth;
+        for (int r = 0; r < rows; ++r) {
+          ReadTile(row0 + r, kk, a[set][r].Data());
+        }
+        for (int j = 0; j < cols; ++j) {
+          other.ReadTile(kk, col0 + j, b[set][j].Data());
+        }
+      },
+      [&](int step, int set) {
+        int row0, col0, rows, cols;
+        block_shape(step, row0, col0, rows, cols);
+        const int kk = step % depth;
+        s21::ThreadPool::Global().ParallelFor(rows * cols, [&](int index) {
+          T* dst = c[index].Data();
+          if (kk == 0) {
+            std::fill_n(dst, tile_size, T(0));
+          }
+          s21::Gemm(tile_, tile_, tile_, T(1), a[set][index / cols].Data(),
+                    tile_, 1, b[set][index % cols].Data(), tile_, 1, T(1),
+                    dst, tile_);
+        });
+        if (kk == depth - 1) {
+          for (int index = 0; index < rows * cols; ++index) {
+            res.WriteTile(row0 + index / cols, col0 + index % cols,
+                          c[index].Data());
+          }
+        }
+      });
+  return res;
+}
+
+template <typename T>
+S21TiledMatrixT<T> S21TiledMatrixT<T>::Transpose(
+    const std::string& path, std::size_t memory_budget) const {
+  CheckBudget(2, memory_budget);
+  CheckOutputPath(path, fd_, -1);
+  S21TiledMatrixT res(path, cols_, rows_, tile_);
+  const int tile_cols = GetTileCols();
+  const int count = GetTileRows() * tile_cols;
+  const int group = static_cast<int>(std::min<std::size_t>(
+      count, memory_budget /
+                 (2 * static_cast<std::size_t>(tile_) * tile_ * sizeof(T))));
+  std::vector<S21MatrixT<T>> tiles[2] = {MakeTiles<T>(group, tile_),
+                                         MakeTiles<T>(group, tile_)};
+  Pipeline(
+      (count + group - 1) / group,
+      [&](int step, int set) {
+        for (int i = 0, index = step * group; i < group && index < count;
+             ++i, ++index) {
+          ReadTile(index / tile_cols, index % tile_cols, tiles[set][i].Data());
+        }
+      },
+      [&](int step, int set) {
+        for (int i = 0, index = step * group; i < group && index < count;
+             ++i, ++index) {
+          s21::TransposeSquareInPlace(tiles[set][i].Data(), tile_, tile_);
+          res.WriteTile(index % tile_cols, index / tile_cols,
+                        tiles[set][i].Data());
+        }
+      });
+  return res;
+}
+
+template class S21TiledMatrixT<float>;
+template class S21TiledMatrixT<double>;
+template class S21TiledMatrixT<long double>;
+template class S21TiledMatrixT<std::int64_t>;
@@ -0,0 +1,129 @@
+#ifndef __S21TILEDMATRIX_H__
+#define __S21TILEDMATRIX_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "s21_matrix_io.h"
+#include "s21_matrix_oop.h"
+
+namespace s21 {
+constexpr char kTiledFileMagic[8] = {'S', '2', '1', 'T', 'I', 'L', 'E', 'D'};
+// Сторона плитки по умолчанию: плитка double - 8 МБ
+constexpr int kDefaultTileSize = 1024;
+// Память по умолчанию под плитки одной операции
+constexpr std::size_t kOutOfCoreBudget = std::size_t(256) << 20;
+}  // namespace s21
+
+/**
+ * @brief Матрица в файле на диске, разбитая на квадратные плитки.
+ * @details
+ * Для матриц, которые не помещаются в память. Файл - заголовок
+ * s21::MatrixFileHeader с магией kTiledFileMagic (в stride - сторона
+ * плитки, checksum не используется) и плитки tile x tile по строкам
+ * сетки плиток, каждая плитка - непрерывный блок по строкам. Крайние
+ * плитки дополнены нулями, поэтому все плитки одного размера и
+ * умножаются без проверок краёв. Новый файл создаётся разреженным: пока
+ * плитку не записали, она читается нулями и не занимает места на диске.
+ *
+ * SumMatrix, MulMatrix и Transpose идут по плиткам и держат в памяти не
+ * больше memory_budget байт буферов. Буферы двойные: пока операция
+ * считает одну группу плиток, следующая группа читается с диска в
+ * отдельном потоке, так что чтение идёт параллельно с вычислениями.
+ * Ошибки ввода-вывода - std::system_error с errno.
+ */
+template <typename T>
+class S21TiledMatrixT final {
+ private:
+  int fd_;
+  int rows_, cols_, tile_;
+  std::string path_;
+
+  void Close() noexcept;
+  std::size_t TileOffset(int tile_row, int tile_col) const noexcept;
+  void CheckTile(int tile_row, int tile_col) const;
+  void CheckBudget(std::size_t tiles, std::size_t budget) const;
+  void WriteBlock(int row, int col, int rows, int cols, const T* src,
+                  std::size_t stride);
+
+ public:
+  S21TiledMatrixT() noexcept;
+  // Новый файл path с нулевой матрицей [rows x cols]
+  S21TiledMatrixT(const std::string& path, int rows, int cols,
+                  int tile = s21::kDefaultTileSize);
+  // Открытие файла, созданного раньше
+  explicit S21TiledMatrixT(const std::string& path);
+  S21TiledMatrixT(const S21TiledMatrixT&) = delete;
+  S21TiledMatrixT(S21TiledMatrixT&& other) noexcept;
+  S21TiledMatrixT& operator=(const S21TiledMatrixT&) = delete;
+  S21TiledMatrixT& operator=(S21TiledMatrixT&& other) noexcept;
+  ~S21TiledMatrixT();
+
+  /**
+   * @brief Перенос матрицы из файла s21::Save в файл плиток path.
+   * @details Исходный файл отображается в память, а копируется по одной
+   * плитке, так что размер матрицы не ограничен памятью.
+   */
+  static S21TiledMatrixT Import(const S21MappedMatrixT<T>& matrix,
+                                const std::string& path,
+                                int tile = s21::kDefaultTileSize);
+
+  // Блок [rows x cols] с позиции (row, col) в память и обратно
+  S21MatrixT<T> GetBlock(int row, int col, int rows, int cols) const;
+  void SetBlock(int row, int col, const S21MatrixT<T>& block);
+  // Вся матрица в памяти
+  S21MatrixT<T> ToMatrix() const;
+
+  /**
+   * @brief Плитка (tile_row, tile_col) в буфер на tile * tile элементов
+   * и обратно.
+   * @details Элементы за краем матрицы в записываемой плитке должны быть
+   * нулями - на этом держится умножение крайних плиток.
+   */
+  void ReadTile(int tile_row, int tile_col, T* dst) const;
+  void WriteTile(int tile_row, int tile_col, const T* src);
+
+  // this += other по плиткам, файл this перезаписывается на месте
+  void SumMatrix(const S21TiledMatrixT& other,
+                 std::size_t memory_budget = s21::kOutOfCoreBudget);
+  /**
+   * @brief Произведение this * other в новый файл path.
+   * @details
+   * Плитки C считаются блоками b x b плиток: блок копится в памяти, а
+   * строка плиток A и столбец плиток B подаются по одной плитке по k.
+   * b - наибольшее, при котором b * b плиток C и два набора по 2 * b
+   * плиток A и B укладываются в memory_budget: плитки A и B читаются с
+   * диска в b раз реже, чем при умножении по одной плитке C. Плитки
+   * умножаются s21::Gemm в пуле потоков. path не может быть файлом this
+   * или other - std::invalid_argument.
+   */
+  S21TiledMatrixT MulMatrix(
+      const S21TiledMatrixT& other, const std::string& path,
+      std::size_t memory_budget = s21::kOutOfCoreBudget) const;
+  // Транспонированная матрица в новый файл path (не в файл this)
+  S21TiledMatrixT Transpose(
+      const std::string& path,
+      std::size_t memory_budget = s21::kOutOfCoreBudget) const;
+
+  int GetRows() const noexcept { return rows_; }
+  int GetCols() const noexcept { return cols_; }
+  int GetTileSize() const noexcept { return tile_; }
+  // Без rows_ + tile_ - 1, которое переполняет int у больших матриц
+  int GetTileRows() const noexcept {
+    return tile_ > 0 ? rows_ / tile_ + (rows_ % tile_ != 0) : 0;
+  }
+  int GetTileCols() const noexcept {
+    return tile_ > 0 ? cols_ / tile_ + (cols_ % tile_ != 0) : 0;
+  }
+  const std::string& GetPath() const noexcept { return path_; }
+};
+
+using S21TiledMatrix = S21TiledMatrixT<double>;
+
+extern template class S21TiledMatrixT<float>;
+extern template class S21TiledMatrixT<double>;
+extern template class S21TiledMatrixT<long double>;
+extern template class S21TiledMatrixT<std::int64_t>;
+
+#endif  //__S21TILEDMATRIX_H__
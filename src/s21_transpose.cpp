@@ -0,0 +1,135 @@
+#include "s21_transpose.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "s21_simd.h"
+
+namespace {
+// Сторона листа рекурсии и блока транспонирования на месте
+constexpr int kLeaf = 32;
+
+template <typename T>
+void TransposeLeaf(const T* src, int rows, int cols, std::size_t src_stride,
+                   T* dst, std::size_t dst_stride,
+                   const s21::SimdKernels<T>& kernels) {
+  const int tile = kernels.transpose_tile;
+  const int full_rows = rows - rows % tile;
+  const int full_cols = cols - cols % tile;
+  for (int i = 0; i < full_rows; i += tile) {
+    for (int j = 0; j < full_cols; j += tile) {
+      kernels.transpose(src + i * src_stride + j, src_stride,
+                        dst + j * dst_stride + i, dst_stride);
+    }
+  }
+  for (int i = 0; i < rows; ++i) {
+    const T* src_row = src + i * src_stride;
+    for (int j = i < full_rows ? full_cols : 0; j < cols; ++j) {
+      dst[j * dst_stride + i] = src_row[j];
+    }
+  }
+}
+
+template <typename T>
+void TransposeRecursive(const T* src, int rows, int cols,
+                        std::size_t src_stride, T* dst, std::size_t dst_stride,
+                        const s21::SimdKernels<T>& kernels) {
+  if (rows <= kLeaf && cols <= kLeaf) {
+    TransposeLeaf(src, rows, cols, src_stride, dst, dst_stride, kernels);
+  } else if (rows >= cols) {
+    // Граница деления кратна kLeaf, чтобы листья были полными
+    const int half = (rows / 2 + kLeaf - 1) / kLeaf * kLeaf;
+    TransposeRecursive(src, half, cols, src_stride, dst, dst_stride, kernels);
+    TransposeRecursive(src + half * src_stride, rows - half, cols, src_stride,
+                       dst + half, dst_stride, kernels);
+  } else {
+    const int half = (cols / 2 + kLeaf - 1) / kLeaf * kLeaf;
+    TransposeRecursive(src, rows, half, src_stride, dst, dst_stride, kernels);
+    TransposeRecursive(src + half, rows, cols - half, src_stride,
+                       dst + half * dst_stride, dst_stride, kernels);
+  }
+}
+
+// Копирование блока [rows x cols] между буферами с разными шагами
+template <typename T>
+void CopyBlock(const T* src, int rows, int cols, std::size_t src_stride,
+               T* dst, std::size_t dst_stride) {
+  for (int i = 0; i < rows; ++i) {
+    std::copy_n(src + i * src_stride, cols, dst + i * dst_stride);
+  }
+}
+}  // namespace
+
+namespace s21 {
+template <typename T>
+void Transpose(const T* src, int rows, int cols, std::size_t src_stride,
+               T* dst, std::size_t dst_stride) {
+  TransposeRecursive(src, rows, cols, src_stride, dst, dst_stride,
+                     GetKernels<T>());
+}
+
+template <typename T>
+void TransposeSquareInPlace(T* data, int n, std::size_t stride) {
+  const SimdKernels<T>& kernels = GetKernels<T>();
+  T upper[kLeaf * kLeaf];
+  T lower[kLeaf * kLeaf];
+  for (int bi = 0; bi < n; bi += kLeaf) {
+    const int rows = std::min(kLeaf, n - bi);
+    T* diagonal = data + bi * stride + bi;
+    TransposeLeaf(diagonal, rows, rows, stride, upper, kLeaf, kernels);
+    CopyBlock(upper, rows, rows, kLeaf, diagonal, stride);
+    for (int bj = bi + kLeaf; bj < n; bj += kLeaf) {
+      const int cols = std::min(kLeaf, n - bj);
+      T* a = data + bi * stride + bj;
+      T* b = data + bj * stride + bi;
+      TransposeLeaf(a, rows, cols, stride, upper, kLeaf, kernels);
+      TransposeLeaf(b, cols, rows, stride, lower, kLeaf, kernels);
+      CopyBlock(upper, cols, rows, kLeaf, b, stride);
+      CopyBlock(lower, rows, cols, kLeaf, a, stride);
+    }
+  }
+}
+
+template <typename T>
+void TransposeInPlace(T* data, int rows, int cols) {
+  if (rows == cols) {
+    TransposeSquareInPlace(data, rows, static_cast<std::size_t>(cols));
+    return;
+  }
+  const std::size_t count = static_cast<std::size_t>(rows) * cols;
+  if (count < 3) {
+    return;
+  }
+  // Первый и последний элементы остаются на месте
+  const std::size_t modulus = count - 1;
+  std::vector<bool> visited(count, false);
+  for (std::size_t start = 1; start < modulus; ++start) {
+    if (visited[start]) {
+      continue;
+    }
+    // Элемент с номером k = i * cols + j уходит на место j * rows + i
+    std::size_t pos = start;
+    T carried = data[start];
+    do {
+      const std::size_t next = pos * rows % modulus;
+      std::swap(carried, data[next]);
+      visited[next] = true;
+      pos = next;
+    } while (pos != start);
+  }
+}
+
+#define S21_TRANSPOSE_INSTANTIATE(T)                                         \
+  template void Transpose(const T* src, int rows, int cols,                 \
+                          std::size_t src_stride, T* dst,                   \
+                          std::size_t dst_stride);                          \
+  template void TransposeSquareInPlace(T* data, int n, std::size_t stride); \
+  template void TransposeInPlace(T* data, int rows, int cols);
+
+S21_TRANSPOSE_INSTANTIATE(float)
+S21_TRANSPOSE_INSTANTIATE(double)
+S21_TRANSPOSE_INSTANTIATE(long double)
+S21_TRANSPOSE_INSTANTIATE(std::int64_t)
+#undef S21_TRANSPOSE_INSTANTIATE
+}  // namespace s21
@@ -0,0 +1,43 @@
+#ifndef __S21TRANSPOSE_H__
+#define __S21TRANSPOSE_H__
+
+#include <cstddef>
+
+namespace s21 {
+/**
+ * @brief Транспонирование [rows x cols] из src в dst: dst[j][i] = src[i][j].
+ * @details
+ * Кэш-независимая рекурсия: большая сторона делится пополам, пока блок
+ * не станет не больше 32 x 32 (источник и результат вместе помещаются в
+ * L1). Лист разбирается регистровыми блоками 2x2/4x4/8x8 по набору
+ * инструкций процессора (см. s21_simd.h), края - скалярно. И чтение, и
+ * запись идут короткими непрерывными отрезками на любом уровне кэша.
+ * src и dst не должны пересекаться. Определены для float, double,
+ * long double и std::int64_t.
+ * @param src_stride, dst_stride шаги строк в элементах
+ */
+template <typename T>
+void Transpose(const T* src, int rows, int cols, std::size_t src_stride,
+               T* dst, std::size_t dst_stride);
+
+/**
+ * @brief Транспонирование квадратной матрицы [n x n] на месте.
+ * @details Блоки по разные стороны от диагонали транспонируются попарно
+ * через два буфера на стеке и меняются местами, диагональные - через один.
+ */
+template <typename T>
+void TransposeSquareInPlace(T* data, int n, std::size_t stride);
+
+/**
+ * @brief Транспонирование плотной матрицы [rows x cols] на месте.
+ * @details Перестановка элементов обходится по циклам: элемент с номером
+ * k переходит на место k * rows mod (rows * cols - 1). Посещённые
+ * элементы отмечаются битовой маской (1 бит на элемент вместо второй
+ * матрицы). Обход циклов обращается к памяти вразброс, поэтому это путь
+ * для экономии памяти, а не скорости.
+ */
+template <typename T>
+void TransposeInPlace(T* data, int rows, int cols);
+}  // namespace s21
+
+#endif  //__S21TRANSPOSE_H__
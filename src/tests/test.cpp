@@ -1,6 +1,32 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "../s21_allocator.h"
+#include "../s21_cholesky.h"
+#include "../s21_fixed_matrix.h"
+#include "../s21_gemm.h"
+#include "../s21_lu.h"
+#include "../s21_matrix_batch.h"
+#include "../s21_matrix_io.h"
 #include "../s21_matrix_oop.h"
+#include "../s21_simd.h"
+#include "../s21_solve.h"
+#include "../s21_sparse_matrix.h"
+#include "../s21_strassen.h"
+#include "../s21_thread_pool.h"
+#include "../s21_tiled_matrix.h"
 
 #define EPS 1e-7
 #define SUCCESS 1
@@ -759,6 +785,1828 @@ TEST(Test_SetCols, Test_2) {
   ASSERT_TRUE(M == M2);
 }
 
+TEST(Test_Storage, Contiguous_1) {
+  S21Matrix M(3, 4);
+  for (int i = 0; i < M.GetRows(); i++) {
+    for (int j = 0; j < M.GetCols(); j++) {
+      M(i, j) = i * 10 + j;
+    }
+  }
+  ASSERT_EQ(M.GetStride(), 4);
+  const double *data = M.Data();
+  for (int i = 0; i < M.GetRows(); i++) {
+    for (int j = 0; j < M.GetCols(); j++) {
+      ASSERT_DOUBLE_EQ(data[i * M.GetStride() + j], i * 10 + j);
+    }
+  }
+}
+
+TEST(Test_Storage, Aligned_1) {
+  S21Matrix M(5, 7);
+  auto address = reinterpret_cast<std::uintptr_t>(M.Data());
+  ASSERT_EQ(address % s21::kMatrixAlignment, 0u);
+  S21Matrix M2(M);
+  address = reinterpret_cast<std::uintptr_t>(M2.Data());
+  ASSERT_EQ(address % s21::kMatrixAlignment, 0u);
+  ASSERT_NE(M.Data(), M2.Data());
+}
+
+S21Matrix NaiveMul(const S21Matrix &a, const S21Matrix &b) {
+  S21Matrix res(a.GetRows(), b.GetCols());
+  for (int i = 0; i < a.GetRows(); i++) {
+    for (int j = 0; j < b.GetCols(); j++) {
+      double sum = 0;
+      for (int k = 0; k < a.GetCols(); k++) {
+        sum += a(i, k) * b(k, j);
+      }
+      res(i, j) = sum;
+    }
+  }
+  return res;
+}
+
+void FillPattern(S21Matrix &m, int seed) {
+  for (int i = 0; i < m.GetRows(); i++) {
+    for (int j = 0; j < m.GetCols(); j++) {
+      m(i, j) = ((i * 31 + j * 17 + seed) % 23) / 7.0 - 1.5;
+    }
+  }
+}
+
+TEST(Test_MulMatrix, Test_8_blocked) {
+  S21Matrix A(67, 131);
+  S21Matrix B(131, 45);
+  FillPattern(A, 1);
+  FillPattern(B, 2);
+  S21Matrix expected = NaiveMul(A, B);
+  A.MulMatrix(B);
+  ASSERT_TRUE(A == expected);
+}
+
+TEST(Test_MulMatrix, Test_9_blockedLarge) {
+  S21Matrix A(20, 270);
+  S21Matrix B(270, 2100);
+  FillPattern(A, 3);
+  FillPattern(B, 4);
+  S21Matrix expected = NaiveMul(A, B);
+  ASSERT_TRUE(A * B == expected);
+}
+
+TEST(Test_Gemm, Strided_1) {
+  S21Matrix A(40, 50);
+  S21Matrix B(60, 40);
+  FillPattern(A, 5);
+  FillPattern(B, 6);
+  S21Matrix C(50, 60);
+  C(3, 3) = 100;
+  // C = 2 * A^T * B^T + C
+  s21::Gemm(50, 60, 40, 2.0, A.Data(), 1, A.GetStride(), B.Data(), 1,
+            B.GetStride(), 1.0, C.Data(), C.GetStride());
+  S21Matrix expected = NaiveMul(A.Transpose(), B.Transpose()) * 2;
+  expected(3, 3) += 100;
+  ASSERT_TRUE(C == expected);
+}
+
+TEST(Test_Gemm, Parallel_1) {
+  // n > kNc и k > kKc: несколько общих панелей B, неполные плитки C
+  S21Matrix A(70, 300);
+  S21Matrix B(2100, 300);
+  FillPattern(A, 48);
+  FillPattern(B, 49);
+  S21Matrix C(70, 2100);
+  const int threads = s21::GetNumThreads();
+  s21::SetNumThreads(4);
+  s21::Gemm(70, 2100, 300, 1.0, A.Data(), A.GetStride(), 1, B.Data(), 1,
+            B.GetStride(), 0.0, C.Data(), C.GetStride());
+  s21::SetNumThreads(threads);
+  ASSERT_TRUE(C == NaiveMul(A, B.Transpose()));
+}
+
+TEST(Test_ThreadPool, ParallelFor_1) {
+  s21::ThreadPool pool(4);
+  ASSERT_EQ(pool.GetThreadCount(), 4);
+  std::vector<std::atomic<int>> hits(1000);
+  pool.ParallelFor(1000, [&](int i) { hits[i]++; });
+  for (auto &hit : hits) {
+    ASSERT_EQ(hit.load(), 1);
+  }
+}
+
+TEST(Test_ThreadPool, Nested_1) {
+  s21::ThreadPool pool(3);
+  std::atomic<int> total(0);
+  pool.ParallelFor(8, [&](int) {
+    pool.ParallelFor(8, [&](int j) { total += j; });
+  });
+  ASSERT_EQ(total.load(), 8 * 28);
+}
+
+TEST(Test_ThreadPool, Wait_1) {
+  // Вызывающий поток ждёт без опроса, пока задачи рабочих порождают
+  // вложенные задачи
+  s21::ThreadPool pool(4);
+  std::atomic<int> total(0);
+  for (int round = 0; round < 20; round++) {
+    pool.ParallelFor(3, [&](int i) {
+      if (i > 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+      }
+      pool.ParallelFor(6, [&](int j) { total += j; });
+    });
+  }
+  ASSERT_EQ(total.load(), 20 * 3 * 15);
+}
+
+TEST(Test_ThreadPool, Global_1) {
+  s21::SetNumThreads(3);
+  s21::ThreadPool *pool = &s21::ThreadPool::Global();
+  ASSERT_EQ(pool->GetThreadCount(), 3);
+  ASSERT_EQ(&s21::ThreadPool::Global(), pool);
+  s21::SetNumThreads(3);
+  ASSERT_EQ(&s21::ThreadPool::Global(), pool);
+  s21::SetNumThreads(2);
+  ASSERT_EQ(s21::GetNumThreads(), 2);
+  s21::SetNumThreads(static_cast<int>(
+      std::max(1u, std::thread::hardware_concurrency())));
+}
+
+TEST(Test_ThreadPool, Exception_1) {
+  s21::ThreadPool pool(2);
+  ASSERT_THROW(pool.ParallelFor(16,
+                                [](int i) {
+                                  if (i == 7) {
+                                    throw std::runtime_error("task");
+                                  }
+                                }),
+               std::runtime_error);
+  ASSERT_ANY_THROW(s21::ThreadPool(0));
+}
+
+TEST(Test_MulMatrix, Test_10_parallel) {
+  S21Matrix A(200, 130);
+  S21Matrix B(130, 600);
+  FillPattern(A, 7);
+  FillPattern(B, 8);
+  S21Matrix expected = NaiveMul(A, B);
+  s21::SetNumThreads(4);
+  ASSERT_EQ(s21::GetNumThreads(), 4);
+  S21Matrix parallel = A * B;
+  s21::SetNumThreads(1);
+  S21Matrix serial = A * B;
+  ASSERT_TRUE(parallel == expected);
+  ASSERT_TRUE(serial == expected);
+  ASSERT_ANY_THROW(s21::SetNumThreads(0));
+}
+
+S21Matrix Identity(int size) {
+  S21Matrix res(size, size);
+  for (int i = 0; i < size; i++) {
+    res(i, i) = 1;
+  }
+  return res;
+}
+
+void FillDominant(S21Matrix &m, int seed) {
+  FillPattern(m, seed);
+  for (int i = 0; i < m.GetRows(); i++) {
+    m(i, i) += m.GetRows();
+  }
+}
+
+TEST(Test_InverseMatrix, Test_7_large) {
+  S21Matrix M(200, 200);
+  FillDominant(M, 9);
+  S21Matrix inverse = M.InverseMatrix();
+  ASSERT_TRUE(M * inverse == Identity(200));
+  ASSERT_TRUE(inverse * M == Identity(200));
+}
+
+TEST(Test_InverseMatrix, Test_8_conditioning) {
+  // Малый масштаб не делает матрицу вырожденной
+  S21Matrix M(20, 20);
+  FillDominant(M, 15);
+  S21Matrix small = M * 1e-9;
+  ASSERT_TRUE(small * small.InverseMatrix() == Identity(20));
+  // Определитель 1000^250 не помещается в double, а обратная есть
+  S21Matrix large = Identity(250) * 1000.0;
+  s21::LogDeterminant<double> det = large.LogAbsDeterminant();
+  ASSERT_EQ(det.sign, 1);
+  ASSERT_NEAR(det.log_abs, 250 * std::log(1000.0), 1e-9);
+  ASSERT_TRUE(large * large.InverseMatrix() == Identity(250));
+  // Все ведущие элементы 1, но число обусловленности около 2^60
+  S21Matrix upper(60, 60);
+  for (int i = 0; i < 60; i++) {
+    upper(i, i) = 1;
+    for (int j = i + 1; j < 60; j++) {
+      upper(i, j) = -1;
+    }
+  }
+  S21LU lu(upper);
+  ASSERT_FALSE(lu.IsSingular());
+  ASSERT_LT(lu.ReciprocalCondition(), 1e-16);
+  ASSERT_THROW(upper.InverseMatrix(), std::invalid_argument);
+  ASSERT_GT(S21LU(M).ReciprocalCondition(), 0.1);
+
+  S21MatrixI64 integer(2, 2);
+  integer(0, 0) = 2;
+  integer(1, 1) = -3;
+  s21::LogDeterminant<double> integer_det = integer.LogAbsDeterminant();
+  ASSERT_EQ(integer_det.sign, -1);
+  ASSERT_NEAR(integer_det.log_abs, std::log(6.0), 1e-12);
+  ASSERT_EQ(S21Matrix(3, 3).LogAbsDeterminant().sign, 0);
+  ASSERT_THROW(S21Matrix(2, 3).LogAbsDeterminant(), std::invalid_argument);
+}
+
+TEST(Test_InverseMatrix, Test_9_wide_range) {
+  // Элементы различаются в 1e8 раз, но матрица хорошо обусловлена
+  S21Matrix M(2, 2);
+  M(0, 0) = 1e8;
+  M(0, 1) = 1;
+  M(1, 1) = 1;
+  S21LU lu(M);
+  ASSERT_FALSE(lu.IsSingular());
+  ASSERT_NEAR(M.Determinant(), 1e8, 1e8 * EPS);
+  s21::LogDeterminant<double> det = M.LogAbsDeterminant();
+  ASSERT_EQ(det.sign, 1);
+  ASSERT_NEAR(det.log_abs, std::log(1e8), 1e-12);
+  S21Matrix inverse = M.InverseMatrix();
+  ASSERT_NEAR(inverse(0, 0), 1e-8, 1e-20);
+  ASSERT_NEAR(inverse(0, 1), -1e-8, 1e-20);
+  ASSERT_NEAR(inverse(1, 0), 0, 1e-20);
+  ASSERT_NEAR(inverse(1, 1), 1, EPS);
+  // Точно вырожденная остаётся вырожденной
+  M(1, 1) = 0;
+  M(1, 0) = 0;
+  M(0, 1) = 0;
+  ASSERT_TRUE(S21LU(M).IsSingular());
+  ASSERT_EQ(M.Determinant(), 0);
+  ASSERT_THROW(M.InverseMatrix(), std::invalid_argument);
+}
+
+TEST(Test_LU, Solve_1) {
+  S21Matrix A(3, 3);
+  A(0, 0) = 2;
+  A(0, 1) = 5;
+  A(0, 2) = 7;
+  A(1, 0) = 6;
+  A(1, 1) = 3;
+  A(1, 2) = 4;
+  A(2, 0) = 5;
+  A(2, 1) = -2;
+  A(2, 2) = -3;
+  S21LU lu(A);
+  ASSERT_FALSE(lu.IsSingular());
+  ASSERT_NEAR(lu.Determinant(), -1, EPS);
+  S21Matrix B(3, 2);
+  FillPattern(B, 10);
+  S21Matrix X = lu.Solve(B);
+  ASSERT_TRUE(A * X == B);
+  ASSERT_TRUE(lu.InverseMatrix() == A.InverseMatrix());
+}
+
+TEST(Test_LU, Singular_1) {
+  S21Matrix A(3, 3);
+  FillPattern(A, 11);
+  for (int j = 0; j < 3; j++) {
+    A(2, j) = A(0, j) + A(1, j);
+  }
+  S21LU lu(A);
+  ASSERT_TRUE(lu.IsSingular());
+  ASSERT_DOUBLE_EQ(lu.Determinant(), 0);
+  ASSERT_ANY_THROW(lu.InverseMatrix());
+  ASSERT_ANY_THROW(S21LU{S21Matrix(2, 3)});
+  ASSERT_ANY_THROW(S21LU{S21Matrix()});
+}
+
+TEST(Test_LU, Blocked_1) {
+  // Строки в обратном порядке: ведущие элементы берутся из других панелей
+  S21Matrix D(300, 300), A(300, 300);
+  FillDominant(D, 13);
+  for (int i = 0; i < 300; i++) {
+    for (int j = 0; j < 300; j++) {
+      A(i, j) = D(299 - i, j);
+    }
+  }
+  S21LU lu(A);
+  S21Matrix B(300, 4);
+  FillPattern(B, 14);
+  ASSERT_TRUE(A * lu.Solve(B) == B);
+  // Обращение 300 строк - 150 перестановок, знак сохраняется.
+  // Сам определитель порядка 300^300 в double не помещается
+  S21LU dominant(D);
+  ASSERT_TRUE(std::isinf(lu.Determinant()));
+  ASSERT_EQ(lu.GetSign(), dominant.GetSign());
+  ASSERT_NEAR(lu.LogAbsDeterminant(), dominant.LogAbsDeterminant(), 1e-9);
+}
+
+TEST(Test_LU, Scaled_1) {
+  // Произведение первых двух элементов диагонали переполняет double,
+  // следующие сто возвращают его к 1
+  S21Matrix A(200, 200);
+  for (int i = 0; i < 200; i++) {
+    A(i, i) = i < 2 ? 1e300 : (i < 102 ? 1e-6 : 1.0);
+  }
+  S21LU lu(A);
+  ASSERT_NEAR(lu.Determinant(), 1.0, EPS);
+  ASSERT_NEAR(A.Determinant(), 1.0, EPS);
+  for (int i = 0; i < 200; i++) {
+    A(i, i) = 1000.0;
+  }
+  S21LU large(A);
+  ASSERT_TRUE(std::isinf(large.Determinant()));
+  ASSERT_NEAR(large.LogAbsDeterminant(), 200 * std::log(1000.0), 1e-9);
+  ASSERT_EQ(large.GetSign(), 1);
+  A(0, 0) = 0;
+  ASSERT_EQ(S21LU(A).GetSign(), 0);
+  ASSERT_TRUE(std::isinf(S21LU(A).LogAbsDeterminant()));
+}
+
+TEST(Test_Solve, Methods_1) {
+  // 150 строк - несколько диагональных блоков, 200 столбцов - две полосы
+  S21Matrix A(150, 150), B(150, 200);
+  FillDominant(A, 16);
+  FillPattern(B, 17);
+  S21Matrix lower(150, 150), upper(150, 150);
+  for (int i = 0; i < 150; i++) {
+    for (int j = 0; j < 150; j++) {
+      (j <= i ? lower : upper)(i, j) = A(i, j);
+    }
+    upper(i, i) = A(i, i);
+  }
+  ASSERT_TRUE(A * s21::Solve(A, B) == B);
+  ASSERT_TRUE(lower * s21::Solve(lower, B) == B);
+  ASSERT_TRUE(upper * s21::Solve(upper, B) == B);
+  ASSERT_TRUE(s21::Solve(upper, B, s21::SolveMethod::kUpperTriangular) ==
+              s21::Solve(upper, B, s21::SolveMethod::kGeneral));
+
+  // A^T * A + E симметрична и положительно определена
+  S21Matrix spd = A.Transpose() * A + Identity(150);
+  for (auto method : {s21::SolveMethod::kAuto, s21::SolveMethod::kGeneral,
+                      s21::SolveMethod::kPositiveDefinite}) {
+    ASSERT_TRUE(spd * s21::Solve(spd, B, method) == B);
+  }
+}
+
+TEST(Test_Solve, Errors_1) {
+  // Симметричная с положительной диагональю, но не положительно определённая
+  S21Matrix A(2, 2), B(2, 1);
+  A(0, 0) = A(1, 1) = 1;
+  A(0, 1) = A(1, 0) = 2;
+  B(0, 0) = 3;
+  B(1, 0) = 3;
+  S21Matrix X = s21::Solve(A, B);
+  ASSERT_NEAR(X(0, 0), 1, EPS);
+  ASSERT_NEAR(X(1, 0), 1, EPS);
+  ASSERT_THROW(s21::Solve(A, B, s21::SolveMethod::kPositiveDefinite),
+               std::invalid_argument);
+  A(0, 1) = 0;
+  A(1, 1) = 0;
+  ASSERT_THROW(s21::Solve(A, B), std::invalid_argument);
+  ASSERT_THROW(s21::Solve(A, S21Matrix(3, 1)), std::invalid_argument);
+  ASSERT_THROW(s21::Solve(S21Matrix(2, 3), B), std::invalid_argument);
+  ASSERT_THROW(s21::Solve(S21Matrix(), B), std::out_of_range);
+
+  // Диагональ различается в 1e8 раз, но система хорошо обусловлена
+  S21Matrix lower(2, 2);
+  lower(0, 0) = 1e8;
+  lower(1, 0) = 1;
+  lower(1, 1) = 1;
+  B(0, 0) = 1e8;
+  B(1, 0) = 2;
+  X = s21::Solve(lower, B);
+  ASSERT_NEAR(X(0, 0), 1, EPS);
+  ASSERT_NEAR(X(1, 0), 1, EPS);
+  X = s21::Solve(lower, B, s21::SolveMethod::kGeneral);
+  ASSERT_NEAR(X(0, 0), 1, EPS);
+  ASSERT_NEAR(X(1, 0), 1, EPS);
+  // Единичная диагональ, но число обусловленности около 2^60
+  S21Matrix upper(60, 60);
+  for (int i = 0; i < 60; i++) {
+    upper(i, i) = 1;
+    for (int j = i + 1; j < 60; j++) {
+      upper(i, j) = -1;
+    }
+  }
+  ASSERT_THROW(s21::Solve(upper, S21Matrix(60, 1)), std::invalid_argument);
+}
+
+TEST(Test_Cholesky, Factor_1) {
+  // 300 строк - три блока разложения и полосы обновления разной высоты
+  S21Matrix A(300, 300);
+  FillDominant(A, 18);
+  S21Matrix spd = A.Transpose() * A + Identity(300);
+  S21Cholesky cholesky = spd.Cholesky();
+  ASSERT_TRUE(cholesky.IsPositiveDefinite());
+  const S21Matrix& L = cholesky.GetFactor();
+  for (int i = 0; i < 300; i++) {
+    for (int j = i + 1; j < 300; j++) {
+      ASSERT_EQ(L(i, j), 0);
+    }
+  }
+  ASSERT_TRUE(L * L.Transpose() == spd);
+
+  S21LU lu(spd);
+  ASSERT_NEAR(cholesky.LogAbsDeterminant(), lu.LogAbsDeterminant(),
+              EPS * std::abs(lu.LogAbsDeterminant()));
+  ASSERT_NEAR(spd.LogAbsDeterminant().log_abs, lu.LogAbsDeterminant(),
+              EPS * std::abs(lu.LogAbsDeterminant()));
+  ASSERT_GT(cholesky.ReciprocalCondition(), 0);
+  ASSERT_TRUE(spd * cholesky.InverseMatrix() == Identity(300));
+  ASSERT_TRUE(spd.InverseMatrix() == cholesky.InverseMatrix());
+  S21Matrix B(300, 5);
+  FillPattern(B, 19);
+  ASSERT_TRUE(spd * cholesky.Solve(B) == B);
+  std::vector<double> x = cholesky.Solve(std::vector<double>(300, 1.0));
+  ASSERT_NEAR(x[7], lu.Solve(std::vector<double>(300, 1.0))[7], EPS);
+
+  S21Matrix small(2, 2);
+  small(0, 0) = 4;
+  small(0, 1) = small(1, 0) = 2;
+  small(1, 1) = 5;
+  ASSERT_NEAR(small.Cholesky().Determinant(), 16, EPS);
+  ASSERT_NEAR(small.Determinant(), 16, EPS);
+}
+
+TEST(Test_Cholesky, Scaled_1) {
+  // Диагональ различается в 1e8 раз, матрица положительно определена
+  S21Matrix D(2, 2);
+  D(0, 0) = 1e8;
+  D(1, 1) = 1;
+  S21Cholesky diagonal(D);
+  ASSERT_TRUE(diagonal.IsPositiveDefinite());
+  ASSERT_NEAR(diagonal.Determinant(), 1e8, 1e8 * EPS);
+  ASSERT_NEAR(D.Determinant(), 1e8, 1e8 * EPS);
+  S21Matrix inverse = D.InverseMatrix();
+  ASSERT_NEAR(inverse(0, 0), 1e-8, 1e-20);
+  ASSERT_NEAR(inverse(1, 1), 1, EPS);
+  // D * S * D с масштабами от 1e-4 до 1e4
+  S21Matrix A(20, 20);
+  FillDominant(A, 20);
+  S21Matrix S = A.Transpose() * A + Identity(20);
+  S21Matrix scaled(20, 20);
+  for (int i = 0; i < 20; i++) {
+    for (int j = 0; j < 20; j++) {
+      scaled(i, j) = S(i, j) * std::pow(10.0, i % 9 - 4) *
+                     std::pow(10.0, j % 9 - 4);
+    }
+  }
+  S21Cholesky cholesky(scaled);
+  ASSERT_TRUE(cholesky.IsPositiveDefinite());
+  S21LU lu(scaled);
+  ASSERT_NEAR(cholesky.LogAbsDeterminant(), lu.LogAbsDeterminant(),
+              EPS * std::abs(lu.LogAbsDeterminant()));
+}
+
+TEST(Test_Cholesky, NotPositiveDefinite_1) {
+  // Симметричная с положительной диагональю, но det = -3
+  S21Matrix A(2, 2);
+  A(0, 0) = A(1, 1) = 1;
+  A(0, 1) = A(1, 0) = 2;
+  S21Cholesky cholesky(A);
+  ASSERT_FALSE(cholesky.IsPositiveDefinite());
+  ASSERT_THROW(cholesky.Determinant(), std::invalid_argument);
+  ASSERT_THROW(cholesky.InverseMatrix(), std::invalid_argument);
+  ASSERT_THROW(cholesky.Solve(S21Matrix(2, 1)), std::invalid_argument);
+  // Determinant и InverseMatrix переходят на LU
+  ASSERT_NEAR(A.Determinant(), -3, EPS);
+  ASSERT_EQ(A.LogAbsDeterminant().sign, -1);
+  ASSERT_TRUE(A * A.InverseMatrix() == Identity(2));
+  ASSERT_THROW(S21Cholesky{S21Matrix(2, 3)}, std::invalid_argument);
+  ASSERT_THROW(S21Cholesky{S21Matrix()}, std::out_of_range);
+}
+
+TEST(Test_LU, Reuse_1) {
+  S21Matrix A(50, 50);
+  FillDominant(A, 12);
+  S21LU lu(A);
+  ASSERT_NEAR(lu.Determinant(), A.Determinant(),
+              EPS * std::abs(lu.Determinant()));
+  S21Matrix B(50, 3);
+  for (int step = 0; step < 10; step++) {
+    FillPattern(B, step);
+    S21Matrix rhs = B;
+    const double *buffer = B.Data();
+    lu.SolveInPlace(B);
+    ASSERT_EQ(B.Data(), buffer);
+    ASSERT_TRUE(A * B == rhs);
+  }
+  std::vector<double> x = lu.Solve(std::vector<double>(50, 1.0));
+  S21Matrix ones(50, 1);
+  for (int i = 0; i < 50; i++) {
+    ones(i, 0) = 1.0;
+  }
+  S21Matrix expected = lu.Solve(ones);
+  for (int i = 0; i < 50; i++) {
+    ASSERT_NEAR(x[i], expected(i, 0), EPS);
+  }
+  S21Matrix wrong(3, 1);
+  ASSERT_ANY_THROW(lu.Solve(std::vector<double>(3)));
+  ASSERT_ANY_THROW(lu.SolveInPlace(wrong));
+}
+
+TEST(Test_Determinant, Test_6_empty) {
+  S21Matrix M(0, 0);
+  ASSERT_DOUBLE_EQ(M.Determinant(), 1.0);
+}
+
+S21Matrix BruteComplements(const S21Matrix &m) {
+  int n = m.GetRows();
+  S21Matrix res(n, n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      S21Matrix minor(n - 1, n - 1);
+      for (int r = 0, mr = 0; r < n; r++) {
+        if (r == i) continue;
+        for (int c = 0, mc = 0; c < n; c++) {
+          if (c == j) continue;
+          minor(mr, mc++) = m(r, c);
+        }
+        mr++;
+      }
+      res(i, j) = ((i + j) % 2 ? -1 : 1) * minor.Determinant();
+    }
+  }
+  return res;
+}
+
+TEST(Test_CalcComplements, Test_4_regular) {
+  S21Matrix M(6, 6);
+  FillPattern(M, 13);
+  ASSERT_TRUE(M.CalcComplements() == BruteComplements(M));
+}
+
+TEST(Test_CalcComplements, Test_5_rankDeficient) {
+  S21Matrix M(5, 5);
+  FillPattern(M, 14);
+  for (int j = 0; j < 5; j++) {
+    M(4, j) = M(0, j) - 2 * M(2, j);
+  }
+  S21Matrix expected = BruteComplements(M);
+  S21Matrix res = M.CalcComplements();
+  ASSERT_TRUE(res == expected);
+  ASSERT_TRUE(M * res.Transpose() == S21Matrix(5, 5));
+}
+
+TEST(Test_CalcComplements, Test_6_zeroRow) {
+  S21Matrix M(3, 3);
+  M(0, 0) = 1;
+  M(0, 1) = 2;
+  M(0, 2) = 3;
+  M(1, 0) = 4;
+  M(1, 1) = 5;
+  M(1, 2) = 7;
+  S21Matrix res = M.CalcComplements();
+  ASSERT_TRUE(res == BruteComplements(M));
+  ASSERT_NEAR(res(2, 0), -1, EPS);
+  ASSERT_NEAR(res(2, 1), 5, EPS);
+  ASSERT_NEAR(res(2, 2), -3, EPS);
+}
+
+// Порог ранга относительный: мелкая вырожденная матрица не считается
+// матрицей ранга меньше n - 1
+TEST(Test_CalcComplements, Test_8_scaled) {
+  S21Matrix M(3, 3);
+  M(0, 0) = 1;
+  M(0, 1) = 2;
+  M(0, 2) = 3;
+  M(1, 0) = 4;
+  M(1, 1) = 5;
+  M(1, 2) = 7;
+  const S21Matrix expected = M.CalcComplements();
+  for (double scale : {1e-9, 1e9}) {
+    S21Matrix res = (M * scale).CalcComplements();
+    res *= 1 / (scale * scale);
+    ASSERT_TRUE(res == expected);
+  }
+}
+
+TEST(Test_CalcComplements, Test_7_lowRank) {
+  S21Matrix M(4, 4);
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      M(i, j) = (i + 1) * (j + 2);
+    }
+  }
+  ASSERT_TRUE(M.CalcComplements() == S21Matrix(4, 4));
+  S21Matrix one(1, 1);
+  ASSERT_DOUBLE_EQ(one.CalcComplements()(0, 0), 1);
+}
+
+double Trace(const S21Matrix &m) {
+  double res = 0;
+  for (int i = 0; i < m.GetRows(); i++) {
+    res += m(i, i);
+  }
+  return res;
+}
+
+TEST(Test_Expression, Fused_1) {
+  S21Matrix A(4, 5);
+  S21Matrix B(4, 5);
+  S21Matrix C(4, 5);
+  FillPattern(A, 15);
+  FillPattern(B, 16);
+  FillPattern(C, 17);
+  S21Matrix res = A + B - C * 2.0;
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 5; j++) {
+      ASSERT_DOUBLE_EQ(res(i, j), A(i, j) + B(i, j) - C(i, j) * 2.0);
+    }
+  }
+  S21Matrix expected = res;
+  // Всё выражение - один проход прямо в буфер res, без временных
+  const double *buffer = res.Data();
+  const std::size_t start = s21::GetAllocationStats().count;
+  res = A + B - C * 2.0;
+  ASSERT_EQ(s21::GetAllocationStats().count - start, 0u);
+  ASSERT_EQ(res.Data(), buffer);
+  ASSERT_TRUE(res == expected);
+  ASSERT_TRUE(A + B - C * 2.0 == expected);
+  ASSERT_TRUE(expected == A + B - C * 2.0);
+}
+
+TEST(Test_Expression, Aliasing_1) {
+  S21Matrix A(3, 3);
+  S21Matrix B(3, 3);
+  FillPattern(A, 18);
+  FillPattern(B, 19);
+  S21Matrix expected = A;
+  expected += B;
+  expected *= 3;
+  A = (A + B) * 3;
+  ASSERT_TRUE(A == expected);
+  A -= B * 3 + A;
+  ASSERT_TRUE(A == B * -3);
+}
+
+TEST(Test_Expression, Temporaries_1) {
+  S21Matrix A(3, 3);
+  FillPattern(A, 20);
+  auto expr = (A * A) * 2 + S21Matrix(3, 3);
+  S21Matrix res = expr;
+  S21Matrix expected = A * A;
+  expected.MulNumber(2);
+  ASSERT_TRUE(res == expected);
+  ASSERT_TRUE((A + A).Transpose() == A.Transpose() * 2);
+  ASSERT_NEAR((A + A).Determinant(), 8 * A.Determinant(), EPS);
+  ASSERT_DOUBLE_EQ(Trace(A - A), 0);
+  ASSERT_TRUE((A + A) * A == expected);
+}
+
+// Константная временная матрица - для проверки листа-владельца
+const S21Matrix MakeConstMatrix(int seed) {
+  S21Matrix res(3, 3);
+  FillPattern(res, seed);
+  return res;
+}
+
+TEST(Test_Expression, Auto_1) {
+  S21Matrix A(3, 3);
+  S21Matrix B(3, 3);
+  FillPattern(A, 46);
+  FillPattern(B, 47);
+  // auto хранит узел: он вычисляется при присваивании и видит текущие
+  // значения lvalue-операндов
+  auto sum = A + B * 2.0;
+  static_assert(s21::IsExprNode<decltype(sum)>::value, "");
+  B *= 0.5;
+  S21Matrix expected = A;
+  expected += B * 2.0;
+  S21Matrix res = sum;
+  ASSERT_TRUE(res == expected);
+  // Временные операнды хранятся по значению и не повисают
+  auto owned = MakeConstMatrix(48) - A;
+  static_assert(s21::IsExprNode<decltype(owned)>::value, "");
+  expected = MakeConstMatrix(48);
+  expected -= A;
+  ASSERT_TRUE(owned == expected);
+  // С неконстантной временной матрицей результат - сама эта матрица
+  auto moved = S21Matrix(A) + B;
+  static_assert(std::is_same<decltype(moved), S21Matrix>::value, "");
+  moved(0, 0) = 100;
+  ASSERT_DOUBLE_EQ(moved(0, 0), 100);
+}
+
+TEST(Test_Expression, Throw_1) {
+  S21Matrix A(3, 3);
+  S21Matrix B(3, 4);
+  ASSERT_ANY_THROW(A + B);
+  ASSERT_ANY_THROW(A - B * 2);
+  ASSERT_ANY_THROW(A += B * 2);
+  ASSERT_ANY_THROW(A -= B + B);
+}
+
+TEST(Test_Simd, AllLevels_1) {
+  const s21::SimdLevel levels[] = {s21::SimdLevel::kScalar,
+                                   s21::SimdLevel::kSse2, s21::SimdLevel::kAvx2,
+                                   s21::SimdLevel::kAvx512};
+  for (s21::SimdLevel level : levels) {
+    if (s21::SetSimdLevel(level) != level) {
+      continue;
+    }
+    ASSERT_EQ(s21::GetKernels().level, level);
+    for (int cols = 1; cols <= 19; cols++) {
+      S21Matrix A(3, cols);
+      S21Matrix B(3, cols);
+      FillPattern(A, cols);
+      FillPattern(B, cols + 1);
+      S21Matrix sum = A;
+      sum.SumMatrix(B);
+      S21Matrix sub = A;
+      sub.SubMatrix(B);
+      S21Matrix mul = A;
+      mul.MulNumber(-2.5);
+      for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < cols; j++) {
+          ASSERT_DOUBLE_EQ(sum(i, j), A(i, j) + B(i, j));
+          ASSERT_DOUBLE_EQ(sub(i, j), A(i, j) - B(i, j));
+          ASSERT_DOUBLE_EQ(mul(i, j), A(i, j) * -2.5);
+        }
+      }
+      for (int k = 0; k < 3 * cols; k++) {
+        S21Matrix C = A;
+        C(k / cols, k % cols) += 1e-6;
+        ASSERT_FALSE(C == A);
+        C(k / cols, k % cols) = A(k / cols, k % cols) + 1e-8;
+        ASSERT_TRUE(C == A);
+      }
+      S21Matrix zero(3, cols);
+      for (int i = 0; i < 3 * cols; i++) {
+        ASSERT_EQ(zero.Data()[i], 0.0);
+      }
+    }
+  }
+  s21::SetSimdLevel(s21::GetMaxSimdLevel());
+}
+
+std::size_t AllocationsSince(std::size_t start) {
+  return s21::GetAllocationStats().count - start;
+}
+
+TEST(Test_Allocation, MulMatrix_1) {
+  S21Matrix A(6, 4);
+  S21Matrix B(4, 5);
+  FillPattern(A, 21);
+  FillPattern(B, 22);
+  S21Matrix expected = NaiveMul(A, B);
+  std::size_t start = s21::GetAllocationStats().count;
+  A.MulMatrix(B);
+  ASSERT_EQ(AllocationsSince(start), 1u);
+  ASSERT_TRUE(A == expected);
+  start = s21::GetAllocationStats().count;
+  S21Matrix res = expected * B.Transpose().Transpose().Transpose();
+  ASSERT_EQ(AllocationsSince(start), 4u);
+  ASSERT_EQ(res.GetRows(), 6);
+  ASSERT_EQ(res.GetCols(), 4);
+}
+
+TEST(Test_Allocation, Chain_1) {
+  S21Matrix A(5, 5);
+  S21Matrix B(5, 5);
+  S21Matrix C(5, 5);
+  FillPattern(A, 23);
+  FillPattern(B, 24);
+  FillPattern(C, 25);
+  S21Matrix product = NaiveMul(A, B);
+
+  std::size_t start = s21::GetAllocationStats().count;
+  S21Matrix res = A * B + C - A * 2.0;
+  ASSERT_EQ(AllocationsSince(start), 1u);
+  ASSERT_TRUE(res == product + C - A * 2.0);
+
+  start = s21::GetAllocationStats().count;
+  res = C - A * B;
+  ASSERT_EQ(AllocationsSince(start), 1u);
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 5; j++) {
+      ASSERT_NEAR(res(i, j), C(i, j) - product(i, j), EPS);
+    }
+  }
+
+  start = s21::GetAllocationStats().count;
+  res = (A + B) * 0.5 + A * B * 3.0;
+  ASSERT_EQ(AllocationsSince(start), 1u);
+  ASSERT_TRUE(res == (A + B) * 0.5 + product * 3.0);
+
+  start = s21::GetAllocationStats().count;
+  res = A + B - C;
+  ASSERT_EQ(AllocationsSince(start), 0u);
+  // Выражение с представлением считается прямо в буфер res
+  start = s21::GetAllocationStats().count;
+  res += S21MatrixView(C).Transpose();
+  ASSERT_EQ(AllocationsSince(start), 0u);
+}
+
+TEST(Test_Allocation, Moves_1) {
+  S21Matrix A(4, 4);
+  FillPattern(A, 26);
+  S21Matrix tmp = A;
+  const double *buffer = tmp.Data();
+  S21Matrix res = std::move(tmp) + A;
+  ASSERT_EQ(res.Data(), buffer);
+  res = A - std::move(res);
+  ASSERT_EQ(res.Data(), buffer);
+  ASSERT_DOUBLE_EQ(Trace(res), -Trace(A));
+  res = std::move(res) * 2.0;
+  ASSERT_EQ(res.Data(), buffer);
+  ASSERT_DOUBLE_EQ(Trace(res), -2 * Trace(A));
+  ASSERT_ANY_THROW(S21Matrix(3, 3) + A);
+  ASSERT_ANY_THROW(A - S21Matrix(4, 3));
+}
+
+TEST(Test_SetRows, Test_3_shrink) {
+  S21Matrix M(4, 3);
+  FillPattern(M, 27);
+  S21Matrix expected = M;
+  M.SetRows(2);
+  ASSERT_EQ(M.GetRows(), 2);
+  for (int i = 0; i < 2; i++) {
+    for (int j = 0; j < 3; j++) {
+      ASSERT_DOUBLE_EQ(M(i, j), expected(i, j));
+    }
+  }
+  M.SetRows(5);
+  for (int j = 0; j < 3; j++) {
+    ASSERT_DOUBLE_EQ(M(1, j), expected(1, j));
+    ASSERT_DOUBLE_EQ(M(2, j), 0);
+    ASSERT_DOUBLE_EQ(M(4, j), 0);
+  }
+}
+
+TEST(Test_SetCols, Test_3_shrinkGrow) {
+  S21Matrix M(3, 4);
+  FillPattern(M, 28);
+  S21Matrix expected = M;
+  const double *buffer = M.Data();
+  M.SetCols(2);
+  M.SetCols(3);
+  ASSERT_EQ(M.Data(), buffer);
+  for (int i = 0; i < 3; i++) {
+    ASSERT_DOUBLE_EQ(M(i, 0), expected(i, 0));
+    ASSERT_DOUBLE_EQ(M(i, 1), expected(i, 1));
+    ASSERT_DOUBLE_EQ(M(i, 2), 0);
+  }
+  M.SetCols(6);
+  ASSERT_EQ(M.GetCols(), 6);
+  for (int i = 0; i < 3; i++) {
+    ASSERT_DOUBLE_EQ(M(i, 1), expected(i, 1));
+    ASSERT_DOUBLE_EQ(M(i, 5), 0);
+  }
+}
+
+TEST(Test_Allocation, Reuse_1) {
+  S21Matrix A(8, 8);
+  S21Matrix B(8, 8);
+  FillPattern(B, 29);
+  std::size_t start = s21::GetAllocationStats().count;
+  A = B;
+  A = A;
+  ASSERT_EQ(AllocationsSince(start), 0u);
+  ASSERT_TRUE(A == B);
+  S21Matrix small(2, 3);
+  FillPattern(small, 30);
+  start = s21::GetAllocationStats().count;
+  A = small;
+  ASSERT_EQ(AllocationsSince(start), 0u);
+  ASSERT_TRUE(A == small);
+  ASSERT_EQ(A.GetCapacity(), 64u);
+  A = B;
+  ASSERT_TRUE(A == B);
+  ASSERT_EQ(AllocationsSince(start), 0u);
+}
+
+TEST(Test_Allocation, Resize_1) {
+  S21Matrix M(1, 16);
+  std::size_t start = s21::GetAllocationStats().count;
+  for (int frame = 2; frame <= 200; frame++) {
+    M.SetRows(frame);
+    M(frame - 1, 0) = frame;
+  }
+  ASSERT_LE(AllocationsSince(start), 15u);
+  ASSERT_DOUBLE_EQ(M(99, 0), 100);
+  M.Reserve(400 * 16);
+  start = s21::GetAllocationStats().count;
+  for (int frame = 0; frame < 100; frame++) {
+    M.SetRows(frame % 2 == 0 ? 400 : 10);
+    M.SetCols(frame % 3 == 0 ? 16 : 8);
+  }
+  ASSERT_EQ(AllocationsSince(start), 0u);
+}
+
+TEST(Test_Allocation, Threads_1) {
+  // Счётчики потоков суммируются, в том числе после завершения потоков
+  std::size_t start = s21::GetAllocationStats().count;
+  {
+    s21::ThreadPool pool(4);
+    pool.ParallelFor(8, [](int i) {
+      S21Matrix tmp(i + 1, 3);
+      tmp(i, 2) = i;
+    });
+    ASSERT_EQ(AllocationsSince(start), 8u);
+  }
+  ASSERT_EQ(AllocationsSince(start), 8u);
+}
+
+TEST(Test_Allocation, Overflow_1) {
+  const std::size_t max = std::numeric_limits<std::size_t>::max();
+  ASSERT_THROW(s21::AllocateBuffer<double>(max / 4), std::bad_alloc);
+  ASSERT_THROW(s21::AllocateBuffer<long double>(max / 8), std::bad_alloc);
+  ASSERT_THROW(s21::AllocateBytes(max - 8), std::bad_alloc);
+  const std::size_t start = s21::GetAllocationStats().count;
+  ASSERT_THROW(s21::AllocateBytes(max - 64), std::bad_alloc);
+  ASSERT_EQ(AllocationsSince(start), 0u);
+}
+
+TEST(Test_Arena, Scope_1) {
+  S21Matrix A(12, 12);
+  FillDominant(A, 31);
+  S21Matrix expected = (A * A + A).InverseMatrix();
+  S21Matrix outside;
+  std::size_t start = s21::GetAllocationStats().heap_count;
+  {
+    S21MatrixArena scope;
+    for (int i = 0; i < 50; i++) {
+      S21Matrix res = (A * A + A).InverseMatrix();
+      ASSERT_TRUE(res == expected);
+    }
+    ASSERT_GT(scope.GetUsedBytes(), 50 * 12 * 12 * sizeof(double));
+    outside = (A * A + A).InverseMatrix();
+  }
+  ASSERT_LE(s21::GetAllocationStats().heap_count - start, 2u);
+  ASSERT_TRUE(outside == expected);
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(outside.Data()) %
+                s21::kMatrixAlignment,
+            0u);
+}
+
+TEST(Test_Arena, Nested_1) {
+  S21Matrix kept;
+  {
+    S21MatrixArena outer(256);
+    S21Matrix a(40, 40);
+    {
+      S21MatrixArena inner;
+      S21Matrix b(3, 3);
+      ASSERT_EQ(outer.GetUsedBytes(), 40 * 40 * sizeof(double) + 64);
+      ASSERT_GT(inner.GetUsedBytes(), 0u);
+      kept = b;
+    }
+    S21Matrix c(2, 2);
+    ASSERT_EQ(outer.GetUsedBytes(), 40 * 40 * sizeof(double) + 64 + 128);
+    a(39, 39) = 5;
+    kept(2, 2) = a(39, 39);
+  }
+  ASSERT_DOUBLE_EQ(kept(2, 2), 5);
+}
+
+TEST(Test_Arena, Pool_1) {
+  S21Matrix A(6, 6);
+  FillPattern(A, 32);
+  S21Matrix warm = A + A * 2.0;
+  std::size_t start = s21::GetAllocationStats().heap_count;
+  for (int i = 0; i < 100; i++) {
+    S21Matrix tmp = A + A * 2.0;
+    ASSERT_DOUBLE_EQ(tmp(5, 5), 3 * A(5, 5));
+  }
+  ASSERT_EQ(s21::GetAllocationStats().heap_count - start, 0u);
+}
+
+TEST(Test_Arena, Threads_1) {
+  S21Matrix A(16, 16);
+  FillDominant(A, 33);
+  S21Matrix expected = A * A;
+  std::vector<S21Matrix> results(8);
+  {
+    S21MatrixArena scope;
+    S21Matrix copy = A;
+    s21::ThreadPool pool(4);
+    pool.ParallelFor(8, [&](int i) { results[i] = copy * copy; });
+  }
+  for (const S21Matrix &res : results) {
+    ASSERT_TRUE(res == expected);
+  }
+}
+
+TEST(Test_View, Slices_1) {
+  S21Matrix A(5, 6);
+  FillPattern(A, 34);
+  S21MatrixView view(A);
+  S21MatrixView block = view.Block(1, 2, 3, 4);
+  ASSERT_EQ(block.GetRows(), 3);
+  ASSERT_EQ(block.GetCols(), 4);
+  ASSERT_DOUBLE_EQ(block(2, 3), A(3, 5));
+  ASSERT_DOUBLE_EQ(view.Row(4)(0, 5), A(4, 5));
+  ASSERT_DOUBLE_EQ(view.Col(2)(3, 0), A(3, 2));
+  ASSERT_DOUBLE_EQ(block.Transpose()(3, 1), A(2, 5));
+  ASSERT_TRUE(view.Transpose() == A.Transpose());
+  block(0, 0) = 100;
+  ASSERT_DOUBLE_EQ(A(1, 2), 100);
+  ASSERT_ANY_THROW(view.Block(3, 0, 3, 1));
+  ASSERT_ANY_THROW(view.Row(5));
+  ASSERT_ANY_THROW(view.Col(-1));
+  const S21Matrix &ref = A;
+  S21ConstMatrixView const_view(ref);
+  ASSERT_DOUBLE_EQ(const_view.Block(1, 2, 1, 1)(0, 0), 100);
+}
+
+TEST(Test_View, Arithmetic_1) {
+  S21Matrix A(6, 6);
+  S21Matrix B(3, 4);
+  FillPattern(A, 35);
+  FillPattern(B, 36);
+  S21MatrixView block = S21MatrixView(A).Block(2, 1, 3, 4);
+  S21Matrix sum = block + B * 2.0 - block;
+  ASSERT_TRUE(sum == B * 2.0);
+  S21Matrix copy = block;
+  S21Matrix expected = NaiveMul(copy.Transpose(), B);
+  std::size_t start = s21::GetAllocationStats().count;
+  S21Matrix product = block.Transpose() * B;
+  ASSERT_EQ(s21::GetAllocationStats().count - start, 1u);
+  ASSERT_TRUE(product == expected);
+  S21Matrix big(80, 70);
+  FillPattern(big, 37);
+  S21MatrixView big_view(big);
+  S21Matrix lhs = big_view.Block(5, 3, 40, 60);
+  S21Matrix rhs = big_view.Block(10, 2, 60, 50).Transpose();
+  ASSERT_TRUE(big_view.Block(5, 3, 40, 60) *
+                  big_view.Block(10, 2, 60, 50) ==
+              NaiveMul(lhs, rhs.Transpose()));
+  ASSERT_ANY_THROW(block + A);
+}
+
+TEST(Test_View, Assign_1) {
+  S21Matrix A(4, 4);
+  FillPattern(A, 38);
+  S21Matrix original = A;
+  S21MatrixView view(A);
+  view.Block(0, 2, 2, 2).Assign(view.Block(2, 0, 2, 2) * 2.0);
+  ASSERT_DOUBLE_EQ(A(1, 3), 2 * original(3, 1));
+  ASSERT_DOUBLE_EQ(A(3, 1), original(3, 1));
+  A = original;
+  view.Assign(view.Transpose());
+  ASSERT_TRUE(A == original.Transpose());
+  A = original;
+  A = S21MatrixView(A).Transpose() + A;
+  ASSERT_TRUE(A == original.Transpose() + original);
+  A = original;
+  A += S21MatrixView(A).Transpose();
+  ASSERT_TRUE(A == original.Transpose() + original);
+  S21MatrixView(A).Row(0).Assign(S21Matrix(1, 4));
+  ASSERT_DOUBLE_EQ(Trace(A) - A(1, 1) - A(2, 2) - A(3, 3), 0);
+  ASSERT_ANY_THROW(S21MatrixView(A).Row(0).Assign(S21MatrixView(A).Col(0)));
+}
+
+TEST(Test_View, Types_1) {
+  S21MatrixF A(6, 5);
+  for (int i = 0; i < 6; i++) {
+    for (int j = 0; j < 5; j++) {
+      A(i, j) = static_cast<float>((i * 7 + j * 3) % 11) - 5;
+    }
+  }
+  S21MatrixViewF block = S21MatrixViewF(A).Block(1, 1, 3, 4);
+  S21MatrixF product = block * block.Transpose();
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      float expected = 0;
+      for (int k = 0; k < 4; k++) {
+        expected += A(i + 1, k + 1) * A(j + 1, k + 1);
+      }
+      ASSERT_FLOAT_EQ(product(i, j), expected);
+    }
+  }
+  S21MatrixF row = S21ConstMatrixViewF(A).Row(2) * 2.0f;
+  ASSERT_FLOAT_EQ(row(0, 4), 2 * A(2, 4));
+  block.Row(0).Assign(S21MatrixF(1, 4));
+  ASSERT_FLOAT_EQ(A(1, 1), 0);
+  S21MatrixLD L(3, 3);
+  L(0, 1) = 2;
+  L(1, 2) = 3;
+  S21MatrixLD square =
+      s21::Multiply(S21ConstMatrixViewLD(L), S21ConstMatrixViewLD(L));
+  ASSERT_EQ(square(0, 2), 6);
+}
+
+void ExpectTransposed(const S21Matrix &res, const S21Matrix &src) {
+  ASSERT_EQ(res.GetRows(), src.GetCols());
+  ASSERT_EQ(res.GetCols(), src.GetRows());
+  for (int i = 0; i < src.GetRows(); i++) {
+    for (int j = 0; j < src.GetCols(); j++) {
+      ASSERT_EQ(res(j, i), src(i, j));
+    }
+  }
+}
+
+TEST(Test_Transpose, Test_3_blocked) {
+  const s21::SimdLevel levels[] = {s21::SimdLevel::kScalar,
+                                   s21::SimdLevel::kSse2, s21::SimdLevel::kAvx2,
+                                   s21::SimdLevel::kAvx512};
+  const int sizes[][2] = {{1, 1},  {2, 2},   {7, 9},   {8, 8},
+                          {33, 5}, {3, 70},  {64, 64}, {97, 130},
+                          {1, 90}, {150, 1}, {71, 71}};
+  for (s21::SimdLevel level : levels) {
+    if (s21::SetSimdLevel(level) != level) {
+      continue;
+    }
+    for (const auto &size : sizes) {
+      S21Matrix A(size[0], size[1]);
+      FillPattern(A, size[0] + size[1]);
+      ExpectTransposed(A.Transpose(), A);
+      S21Matrix in_place = A;
+      in_place.TransposeInPlace();
+      ExpectTransposed(in_place, A);
+    }
+  }
+  s21::SetSimdLevel(s21::GetMaxSimdLevel());
+}
+
+TEST(Test_Transpose, Test_4_inPlace) {
+  S21Matrix A(45, 17);
+  for (int i = 0; i < 45; i++) {
+    for (int j = 0; j < 17; j++) {
+      A(i, j) = i * 100 + j;
+    }
+  }
+  S21Matrix B = A;
+  const double *buffer = B.Data();
+  std::size_t start = s21::GetAllocationStats().count;
+  B.TransposeInPlace();
+  ASSERT_EQ(s21::GetAllocationStats().count - start, 0u);
+  ASSERT_EQ(B.Data(), buffer);
+  ExpectTransposed(B, A);
+  B.TransposeInPlace();
+  ASSERT_TRUE(B == A);
+  S21Matrix empty;
+  empty.TransposeInPlace();
+  ASSERT_EQ(empty.GetRows(), 0);
+}
+
+template <typename L, typename R, typename = void>
+struct CanAdd : std::false_type {};
+template <typename L, typename R>
+struct CanAdd<L, R,
+              std::void_t<decltype(std::declval<L>() + std::declval<R>())>>
+    : std::true_type {};
+
+template <typename L, typename R, typename = void>
+struct CanMul : std::false_type {};
+template <typename L, typename R>
+struct CanMul<L, R,
+              std::void_t<decltype(std::declval<L>() * std::declval<R>())>>
+    : std::true_type {};
+
+static_assert(CanAdd<S21Matrix3d, S21Matrix3d>::value, "");
+static_assert(!CanAdd<S21FixedMatrix<2, 3>, S21FixedMatrix<3, 2>>::value, "");
+static_assert(CanMul<S21FixedMatrix<2, 3>, S21FixedMatrix<3, 4>>::value, "");
+static_assert(!CanMul<S21FixedMatrix<2, 3>, S21FixedMatrix<2, 3>>::value, "");
+static_assert(S21Matrix4d::Identity().Determinant() == 1.0, "");
+
+// Допуск сравнения - ScalarTraits<T>::kEpsilon для каждого типа
+template <typename T>
+constexpr bool FixedEqualWithin(T diff) {
+  S21FixedMatrix<2, 2, T> a, b;
+  b(1, 0) = diff;
+  return a == b;
+}
+static_assert(FixedEqualWithin(5e-5f) && !FixedEqualWithin(5e-4f), "");
+static_assert(FixedEqualWithin(5e-8) && !FixedEqualWithin(5e-7), "");
+static_assert(FixedEqualWithin(5e-11L) && !FixedEqualWithin(5e-8L), "");
+
+template <int N>
+void CheckFixedSquare(int seed) {
+  using Fixed = S21FixedMatrix<N, N>;
+  S21Matrix dynamic(N, N);
+  FillDominant(dynamic, seed);
+  Fixed fixed(dynamic);
+  ASSERT_NEAR(fixed.Determinant(), dynamic.Determinant(),
+              1e-9 * std::fabs(dynamic.Determinant()));
+  Fixed inverse = fixed.InverseMatrix();
+  ASSERT_TRUE(inverse * fixed == Fixed::Identity());
+  ASSERT_TRUE(static_cast<S21Matrix>(inverse) == dynamic.InverseMatrix());
+  ASSERT_TRUE(static_cast<S21Matrix>(fixed * fixed) == dynamic * dynamic);
+  ASSERT_TRUE(static_cast<S21Matrix>(fixed.Transpose()) ==
+              dynamic.Transpose());
+  ASSERT_ANY_THROW(Fixed().InverseMatrix());
+}
+
+TEST(Test_FixedMatrix, Square_1) {
+  CheckFixedSquare<1>(39);
+  CheckFixedSquare<2>(40);
+  CheckFixedSquare<3>(41);
+  CheckFixedSquare<4>(42);
+  CheckFixedSquare<5>(43);
+  CheckFixedSquare<7>(44);
+}
+
+TEST(Test_FixedMatrix, Arithmetic_1) {
+  S21Matrix dynamic(2, 3);
+  FillPattern(dynamic, 45);
+  S21FixedMatrix<2, 3> a(dynamic);
+  S21FixedMatrix<3, 4> b;
+  b(2, 3) = 2;
+  S21FixedMatrix<2, 4> product = a * b;
+  ASSERT_DOUBLE_EQ(product(1, 3), 2 * a(1, 2));
+  ASSERT_DOUBLE_EQ(product(0, 0), 0);
+  S21FixedMatrix<2, 3> sum = a + a * 2 - 0.5 * a;
+  ASSERT_TRUE(static_cast<S21Matrix>(sum) == dynamic * 2.5);
+  a *= S21Matrix3d::Identity();
+  ASSERT_TRUE(static_cast<S21Matrix>(a) == dynamic);
+  using Tall = S21FixedMatrix<3, 2>;
+  ASSERT_ANY_THROW(Tall{dynamic});
+  S21Matrix3f rotation;
+  rotation(0, 1) = -1;
+  rotation(1, 0) = 1;
+  rotation(2, 2) = 1;
+  ASSERT_FLOAT_EQ(rotation.Determinant(), 1.0f);
+  ASSERT_TRUE(rotation.InverseMatrix() == rotation.Transpose());
+  S21MatrixF dynamic_rotation = static_cast<S21MatrixF>(rotation);
+  ASSERT_FLOAT_EQ(dynamic_rotation(0, 1), -1.0f);
+  S21MatrixF doubled = dynamic_rotation * 2.0f;
+  ASSERT_TRUE(S21Matrix3f(doubled) == rotation * 2.0f);
+  S21MatrixLD precise(2, 2);
+  precise(0, 0) = 1 + 1e-15L;
+  S21FixedMatrix<2, 2, long double> fixed_precise(precise);
+  ASSERT_EQ(fixed_precise(0, 0), precise(0, 0));
+  ASSERT_TRUE(static_cast<S21MatrixLD>(fixed_precise) == precise);
+  ASSERT_EQ(sizeof(S21Matrix4d), 16 * sizeof(double));
+}
+
+template <typename T>
+S21MatrixT<T> ConvertMatrix(const S21Matrix &m) {
+  S21MatrixT<T> res(m.GetRows(), m.GetCols());
+  for (int i = 0; i < m.GetRows(); i++) {
+    for (int j = 0; j < m.GetCols(); j++) {
+      res(i, j) = static_cast<T>(m(i, j));
+    }
+  }
+  return res;
+}
+
+TEST(Test_ScalarType, Float_1) {
+  S21Matrix A(37, 53), B(37, 53);
+  FillPattern(A, 46);
+  FillPattern(B, 47);
+  S21MatrixF a = ConvertMatrix<float>(A), b = ConvertMatrix<float>(B);
+  const s21::SimdLevel levels[] = {s21::SimdLevel::kScalar,
+                                   s21::SimdLevel::kSse2, s21::SimdLevel::kAvx2,
+                                   s21::SimdLevel::kAvx512};
+  for (s21::SimdLevel level : levels) {
+    if (s21::SetSimdLevel(level) != level) {
+      continue;
+    }
+    S21MatrixF sum = a + b * 2.0 - a;
+    ASSERT_TRUE(sum == ConvertMatrix<float>(B * 2));
+    S21MatrixF diff = a;
+    diff -= b;
+    diff.MulNumber(0.5f);
+    ASSERT_TRUE(diff == ConvertMatrix<float>((A - B) * 0.5));
+    ASSERT_TRUE(a.Transpose() == ConvertMatrix<float>(A.Transpose()));
+    S21MatrixF shifted = a;
+    shifted(36, 52) += 5e-5f;
+    ASSERT_TRUE(shifted == a);
+    shifted(36, 52) += 2e-4f;
+    ASSERT_FALSE(shifted == a);
+  }
+  s21::SetSimdLevel(s21::GetMaxSimdLevel());
+  S21Matrix C(53, 40);
+  FillPattern(C, 48);
+  S21MatrixF product = a * ConvertMatrix<float>(C);
+  S21Matrix expected = A * C;
+  for (int i = 0; i < product.GetRows(); i++) {
+    for (int j = 0; j < product.GetCols(); j++) {
+      ASSERT_NEAR(product(i, j), expected(i, j), 1e-3);
+    }
+  }
+}
+
+TEST(Test_ScalarType, Floating_1) {
+  S21Matrix A(6, 6);
+  FillDominant(A, 49);
+  S21MatrixF a = ConvertMatrix<float>(A);
+  S21MatrixLD l = ConvertMatrix<long double>(A);
+  ASSERT_NEAR(a.Determinant(), A.Determinant(), 1e-5 * A.Determinant());
+  ASSERT_NEAR(static_cast<double>(l.Determinant()), A.Determinant(),
+              1e-12 * A.Determinant());
+  S21MatrixF identity_f(6, 6);
+  S21MatrixLD identity_l(6, 6);
+  for (int i = 0; i < 6; i++) {
+    identity_f(i, i) = 1;
+    identity_l(i, i) = 1;
+  }
+  ASSERT_TRUE(a * a.InverseMatrix() == identity_f);
+  ASSERT_TRUE(l.InverseMatrix() * l == identity_l);
+  for (int j = 0; j < 6; j++) {
+    A(5, j) = A(0, j) + A(1, j);
+    l(5, j) = l(0, j) + l(1, j);
+  }
+  ASSERT_ANY_THROW(l.InverseMatrix());
+  ASSERT_TRUE(l.CalcComplements() ==
+              ConvertMatrix<long double>(BruteComplements(A)));
+}
+
+void ExpectExactComplements(const S21MatrixI64 &m) {
+  S21Matrix real(m.GetRows(), m.GetCols());
+  for (int i = 0; i < m.GetRows(); i++) {
+    for (int j = 0; j < m.GetCols(); j++) {
+      real(i, j) = static_cast<double>(m(i, j));
+    }
+  }
+  S21Matrix expected = BruteComplements(real);
+  S21MatrixI64 res = m.CalcComplements();
+  for (int i = 0; i < m.GetRows(); i++) {
+    for (int j = 0; j < m.GetCols(); j++) {
+      ASSERT_EQ(res(i, j), std::llround(expected(i, j)));
+    }
+  }
+}
+
+TEST(Test_ScalarType, Int64_1) {
+  // Определитель больше 2^53 - в double он уже не точен
+  const std::int64_t big = std::int64_t(1) << 20;
+  S21MatrixI64 A(3, 3);
+  A(0, 1) = big + 1;
+  A(0, 2) = 7;
+  A(1, 0) = big + 3;
+  A(1, 2) = 5;
+  A(2, 0) = 11;
+  A(2, 1) = 13;
+  A(2, 2) = big + 5;
+  const __int128 expected = -__int128(big + 1) * ((big + 3) * (big + 5) - 55) +
+                            __int128(7) * ((big + 3) * 13);
+  ASSERT_EQ(A.Determinant(), static_cast<std::int64_t>(expected));
+  ASSERT_TRUE(A.Transpose() * A.Transpose() == (A * A).Transpose());
+  ASSERT_THROW(A.InverseMatrix(), std::domain_error);
+
+  S21MatrixI64 B(5, 5);
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 5; j++) {
+      B(i, j) = (i * 7 + j * 3) % 5 - 2;
+    }
+  }
+  ASSERT_EQ(B.Determinant(), 0);
+  ExpectExactComplements(B);
+  B(0, 0) += 3;
+  ASSERT_NE(B.Determinant(), 0);
+  ExpectExactComplements(B);
+
+  // Унимодулярная матрица - обратная тоже целая
+  S21MatrixI64 U(4, 4), L(4, 4), E(4, 4);
+  for (int i = 0; i < 4; i++) {
+    E(i, i) = 1;
+    for (int j = i; j < 4; j++) {
+      U(i, j) = i == j ? 1 : i + 2 * j;
+      L(j, i) = i == j ? 1 : j - i - 3;
+    }
+  }
+  S21MatrixI64 M = L * U;
+  ASSERT_EQ(M.Determinant(), 1);
+  ASSERT_TRUE(M * M.InverseMatrix() == E);
+  ASSERT_TRUE(M.InverseMatrix() * M == E);
+  ASSERT_THROW(S21MatrixI64(3, 3).InverseMatrix(), std::invalid_argument);
+}
+
+// Набор из count матриц: доминантные со сдвигом строк, чтобы был нужен
+// выбор главного элемента, и у каждой своя перестановка
+S21MatrixBatch MakeBatch(std::size_t count, int n, int seed) {
+  S21MatrixBatch res(count, n, n);
+  for (std::size_t index = 0; index < count; index++) {
+    S21Matrix m(n, n);
+    FillDominant(m, seed + static_cast<int>(index));
+    S21Matrix shifted(n, n);
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < n; j++) {
+        shifted((i + static_cast<int>(index)) % n, j) = m(i, j);
+      }
+    }
+    res.Set(index, shifted);
+  }
+  return res;
+}
+
+TEST(Test_Batch, Operations_1) {
+  for (int n = 1; n <= 8; n++) {
+    const std::size_t count = 19;
+    S21MatrixBatch a = MakeBatch(count, n, n);
+    S21MatrixBatch b = MakeBatch(count, n, 3 * n);
+    S21MatrixBatch sum = s21::BatchSum(a, b);
+    S21MatrixBatch product = s21::BatchMulMatrix(a, b);
+    std::vector<double> det = s21::BatchDeterminant(a);
+    S21MatrixBatch inverse = s21::BatchInverse(a);
+    ASSERT_EQ(det.size(), count);
+    for (std::size_t i = 0; i < count; i++) {
+      ASSERT_TRUE(sum.Get(i) == a.Get(i) + b.Get(i));
+      ASSERT_TRUE(product.Get(i) == a.Get(i) * b.Get(i));
+      const double expected = a.Get(i).Determinant();
+      ASSERT_NEAR(det[i], expected, 1e-9 * std::fabs(expected));
+      ASSERT_TRUE(inverse.Get(i) == a.Get(i).InverseMatrix());
+    }
+  }
+}
+
+TEST(Test_Batch, Shapes_1) {
+  S21MatrixBatch a(10, 2, 3), b(10, 3, 4);
+  for (std::size_t i = 0; i < 10; i++) {
+    S21Matrix x(2, 3), y(3, 4);
+    FillPattern(x, static_cast<int>(i));
+    FillPattern(y, static_cast<int>(i) + 5);
+    a.Set(i, x);
+    b.Set(i, y);
+  }
+  S21MatrixBatch product = s21::BatchMulMatrix(a, b);
+  ASSERT_EQ(product.GetRows(), 2);
+  ASSERT_EQ(product.GetCols(), 4);
+  ASSERT_EQ(product.GetGroupCount(), 2u);
+  for (std::size_t i = 0; i < 10; i++) {
+    ASSERT_TRUE(product.Get(i) == NaiveMul(a.Get(i), b.Get(i)));
+  }
+  ASSERT_THROW(s21::BatchMulMatrix(b, b), std::invalid_argument);
+  ASSERT_THROW(s21::BatchSum(a, b), std::out_of_range);
+  ASSERT_THROW(s21::BatchDeterminant(a), std::invalid_argument);
+  ASSERT_THROW(a.Get(10), std::out_of_range);
+  ASSERT_THROW(a.Set(0, S21Matrix(3, 2)), std::out_of_range);
+  ASSERT_THROW(S21MatrixBatch(1, -1, 2), std::length_error);
+}
+
+TEST(Test_Batch, Singular_1) {
+  S21MatrixBatch a = MakeBatch(11, 3, 1);
+  S21Matrix m = a.Get(9);
+  for (int j = 0; j < 3; j++) {
+    m(2, j) = m(0, j) - m(1, j);
+  }
+  a.Set(9, m);
+  // Нулевая строка даёт точно нулевой ведущий элемент
+  S21Matrix zero_row = a.Get(7);
+  for (int j = 0; j < 3; j++) {
+    zero_row(2, j) = 0;
+  }
+  a.Set(7, zero_row);
+  std::vector<double> det = s21::BatchDeterminant(a);
+  ASSERT_EQ(det[7], 0.0);
+  ASSERT_EQ(det[7], S21LU(zero_row).Determinant());
+  ASSERT_NEAR(det[9], 0.0, EPS);
+  ASSERT_NE(det[8], 0.0);
+  ASSERT_NE(det[10], 0.0);
+  // Разность строк вырождена с точностью до округления - по обусловленности
+  ASSERT_THROW(s21::BatchInverse(a), std::invalid_argument);
+  a.Set(7, a.Get(8));
+  ASSERT_THROW(s21::BatchInverse(a), std::invalid_argument);
+  // Элементы разного масштаба не делают матрицу вырожденной
+  S21Matrix wide(3, 3);
+  wide(0, 0) = 1e8;
+  wide(0, 1) = 1;
+  wide(1, 1) = 1;
+  wide(2, 2) = 1;
+  a.Set(8, wide);
+  ASSERT_NEAR(s21::BatchDeterminant(a)[8], 1e8, 1e8 * EPS);
+  // Нулевые матрицы дополнения последней группы не мешают обращению
+  a.Set(9, a.Get(10));
+  S21MatrixBatch inverse = s21::BatchInverse(a);
+  ASSERT_TRUE(inverse.Get(10) == a.Get(10).InverseMatrix());
+  ASSERT_NEAR(inverse.Get(8)(0, 0), 1e-8, 1e-20);
+  ASSERT_NEAR(inverse.Get(8)(0, 1), -1e-8, 1e-20);
+}
+
+// |x - y| <= tolerance * max|y| по всем элементам
+template <typename T>
+bool NearMatrix(const S21MatrixT<T> &x, const S21Matrix &y,
+                double tolerance) {
+  double scale = 0, diff = 0;
+  for (int i = 0; i < y.GetRows(); i++) {
+    for (int j = 0; j < y.GetCols(); j++) {
+      scale = std::max(scale, std::fabs(y(i, j)));
+      diff = std::max(diff, std::fabs(x(i, j) - y(i, j)));
+    }
+  }
+  return diff <= tolerance * scale;
+}
+
+TEST(Test_Batch, Float_1) {
+  ASSERT_EQ(S21MatrixBatchF::kLanes, 16);
+  for (int n = 1; n <= 8; n++) {
+    // Больше 16 матриц: вторая группа float дополнена нулевыми
+    const std::size_t count = 19;
+    S21MatrixBatch a = MakeBatch(count, n, n);
+    S21MatrixBatch b = MakeBatch(count, n, 3 * n);
+    S21MatrixBatchF af(count, n, n), bf(count, n, n);
+    for (std::size_t i = 0; i < count; i++) {
+      af.Set(i, ConvertMatrix<float>(a.Get(i)));
+      bf.Set(i, ConvertMatrix<float>(b.Get(i)));
+    }
+    ASSERT_EQ(af.GetGroupCount(), 2u);
+    S21MatrixBatchF sum = s21::BatchSum(af, bf);
+    S21MatrixBatchF product = s21::BatchMulMatrix(af, bf);
+    std::vector<float> det = s21::BatchDeterminant(af);
+    S21MatrixBatchF inverse = s21::BatchInverse(af);
+    ASSERT_EQ(det.size(), count);
+    for (std::size_t i = 0; i < count; i++) {
+      ASSERT_TRUE(NearMatrix(sum.Get(i), a.Get(i) + b.Get(i), 1e-6));
+      ASSERT_TRUE(NearMatrix(product.Get(i), a.Get(i) * b.Get(i), 1e-5));
+      const double expected = a.Get(i).Determinant();
+      ASSERT_NEAR(det[i], expected, 1e-5 * std::fabs(expected));
+      ASSERT_TRUE(NearMatrix(inverse.Get(i), a.Get(i).InverseMatrix(), 1e-5));
+    }
+  }
+  S21MatrixBatchF singular(3, 2, 2);
+  ASSERT_EQ(s21::BatchDeterminant(singular)[2], 0.0f);
+  ASSERT_THROW(s21::BatchInverse(singular), std::invalid_argument);
+}
+
+// Плотная матрица, где ненулевой примерно каждый density-й элемент
+S21Matrix SparsePattern(int rows, int cols, int density, int seed) {
+  S21Matrix res(rows, cols);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) {
+      if ((i * 13 + j * 7 + seed) % density == 0) {
+        res(i, j) = (i + 2 * j + seed) % 9 - 4.5;
+      }
+    }
+  }
+  return res;
+}
+
+TEST(Test_Sparse, Convert_1) {
+  S21Matrix dense = SparsePattern(37, 23, 5, 1);
+  const S21SparseFormat formats[] = {S21SparseFormat::kCsr,
+                                     S21SparseFormat::kCsc};
+  for (S21SparseFormat format : formats) {
+    S21SparseMatrix sparse(dense, format);
+    ASSERT_EQ(sparse.GetFormat(), format);
+    ASSERT_TRUE(sparse.ToDense() == dense);
+    ASSERT_TRUE(sparse.Transpose().ToDense() == dense.Transpose());
+    ASSERT_EQ(sparse(3, 4), dense(3, 4));
+    ASSERT_EQ(sparse(0, 0), dense(0, 0));
+  }
+  S21SparseMatrix csr(dense), csc(dense, S21SparseFormat::kCsc);
+  ASSERT_EQ(csr.GetNonZeros(), csc.GetNonZeros());
+  ASSERT_TRUE(csr == csc);
+  ASSERT_TRUE(csr.ToFormat(S21SparseFormat::kCsc).Indices() == csc.Indices());
+
+  S21SparseMatrix built = S21SparseMatrix::FromTriplets(
+      3, 4, {{2, 1, 1.5}, {0, 3, 2}, {2, 1, 2.5}, {1, 0, 1}, {1, 0, -1}},
+      S21SparseFormat::kCsc);
+  ASSERT_EQ(built.GetNonZeros(), 2u);
+  ASSERT_EQ(built(2, 1), 4);
+  ASSERT_EQ(built(0, 3), 2);
+  ASSERT_EQ(built(1, 0), 0);
+  ASSERT_THROW(built(3, 0), std::out_of_range);
+  ASSERT_THROW(S21SparseMatrix::FromTriplets(2, 2, {{2, 0, 1}}),
+               std::out_of_range);
+  ASSERT_THROW(S21SparseMatrix(2, 2, S21SparseFormat::kCsr, {0, 2, 1}, {0, 1},
+                               {1, 2}),
+               std::invalid_argument);
+  ASSERT_THROW(S21SparseMatrix(2, 2, S21SparseFormat::kCsr, {0, 2, 2}, {1, 0},
+                               {1, 2}),
+               std::invalid_argument);
+  ASSERT_THROW(S21SparseMatrix(-1, 2), std::length_error);
+}
+
+TEST(Test_Sparse, Arithmetic_1) {
+  S21Matrix a = SparsePattern(29, 31, 4, 2);
+  S21Matrix b = SparsePattern(29, 31, 3, 5);
+  S21Matrix c = SparsePattern(31, 17, 6, 7);
+  S21Matrix d = SparsePattern(17, 11, 2, 3);
+  const S21SparseFormat formats[] = {S21SparseFormat::kCsr,
+                                     S21SparseFormat::kCsc};
+  for (S21SparseFormat left : formats) {
+    for (S21SparseFormat right : formats) {
+      S21SparseMatrix sa(a, left), sb(b, right), sc(c, right);
+      ASSERT_TRUE((sa + sb).ToDense() == a + b);
+      ASSERT_TRUE((sa - sb).ToDense() == a - b);
+      ASSERT_EQ((sa - sa).GetNonZeros(), 0u);
+      S21SparseMatrix product = sa * sc;
+      ASSERT_EQ(product.GetFormat(), left);
+      ASSERT_TRUE(product.ToDense() == NaiveMul(a, c));
+      ASSERT_TRUE(product == S21SparseMatrix(NaiveMul(a, c), right));
+    }
+    S21SparseMatrix sa(a, left), sc(c, left);
+    ASSERT_TRUE(sa * c == NaiveMul(a, c));
+    ASSERT_TRUE(a.Transpose() * sa == NaiveMul(a.Transpose(), a));
+    ASSERT_TRUE(s21::Multiply(sc, d) == NaiveMul(c, d));
+    S21Matrix x(31, 1);
+    FillPattern(x, 4);
+    std::vector<double> vx(x.Data(), x.Data() + 31);
+    std::vector<double> y = sa * vx;
+    S21Matrix expected = NaiveMul(a, x);
+    for (int i = 0; i < 29; i++) {
+      ASSERT_NEAR(y[i], expected(i, 0), 1e-9);
+    }
+    ASSERT_TRUE((2.0 * sa).ToDense() == a * 2.0);
+    sa *= 0.0;
+    ASSERT_EQ(sa.GetNonZeros(), 0u);
+  }
+  S21SparseMatrix sa(a);
+  ASSERT_THROW(sa + S21SparseMatrix(c), std::out_of_range);
+  ASSERT_THROW(sa * S21SparseMatrix(a), std::invalid_argument);
+  ASSERT_THROW(sa * a, std::invalid_argument);
+  ASSERT_THROW(sa.MulVector(std::vector<double>(3)), std::invalid_argument);
+}
+
+TEST(Test_Strassen, Multiply_1) {
+  // Нечётные размеры на каждом уровне - проверка отщепления
+  S21Matrix A(75, 61), B(61, 53);
+  FillPattern(A, 3);
+  FillPattern(B, 4);
+  S21Matrix expected = NaiveMul(A, B);
+  for (int crossover : {2, 7, 16, 64}) {
+    ASSERT_TRUE(s21::MultiplyStrassen(A, B, crossover) == expected);
+  }
+  S21MatrixF Af = ConvertMatrix<float>(A), Bf = ConvertMatrix<float>(B);
+  S21MatrixF product = s21::MultiplyStrassen(Af, Bf, 8);
+  for (int i = 0; i < 75; i++) {
+    for (int j = 0; j < 53; j++) {
+      ASSERT_NEAR(product(i, j), expected(i, j), 1e-3);
+    }
+  }
+  ASSERT_THROW(s21::MultiplyStrassen(A, A, 8), std::invalid_argument);
+  ASSERT_THROW(s21::MultiplyStrassen(A, B, 1), std::invalid_argument);
+}
+
+TEST(Test_Strassen, MulMatrix_1) {
+  S21Matrix A(96, 96), B(96, 96);
+  FillPattern(A, 5);
+  FillPattern(B, 6);
+  S21Matrix expected = NaiveMul(A, B);
+  ASSERT_EQ(s21::SetStrassenCrossover(16), 0);
+  S21Matrix product = A * B;
+  A.MulMatrix(B);
+  ASSERT_EQ(s21::SetStrassenCrossover(0), 16);
+  ASSERT_TRUE(product == expected);
+  ASSERT_TRUE(A == expected);
+  ASSERT_THROW(s21::SetStrassenCrossover(1), std::invalid_argument);
+  ASSERT_EQ(s21::GetStrassenCrossover(), 0);
+}
+
+TEST(Test_MatrixIO, SaveLoad_1) {
+  const std::string path = "test.s21m";
+  S21Matrix A(37, 23);
+  FillPattern(A, 8);
+  s21::Save(A, path);
+  ASSERT_TRUE(s21::Load<double>(path) == A);
+  {
+    S21MappedMatrix mapped(path, true);
+    ASSERT_EQ(mapped.GetRows(), 37);
+    ASSERT_EQ(mapped.GetCols(), 23);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(mapped.Data()) %
+                  s21::kMatrixAlignment,
+              0u);
+    ASSERT_EQ(mapped(5, 7), A(5, 7));
+    ASSERT_TRUE(mapped.ToMatrix() == A);
+    S21Matrix product = mapped.View() * A.Transpose();
+    ASSERT_TRUE(product == NaiveMul(A, A.Transpose()));
+  }
+  {
+    S21MatrixF F(9, 4);
+    F(8, 3) = 1.5f;
+    s21::Save(F, path);
+    S21MappedMatrixT<float> mapped(path);
+    S21MatrixF column = mapped.View().Col(3) * 2.0f;
+    ASSERT_FLOAT_EQ(column(8, 0), 3.0f);
+    s21::Save(A, path);
+  }
+  ASSERT_THROW(s21::Load<float>(path), std::invalid_argument);
+  ASSERT_THROW(S21MappedMatrixT<std::int64_t>{path}, std::invalid_argument);
+
+  // Испорченный элемент находится по контрольной сумме
+  {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(sizeof(s21::MatrixFileHeader) + 100);
+    file.put('\x7f');
+  }
+  ASSERT_THROW(s21::Load<double>(path), std::runtime_error);
+  ASSERT_FALSE(S21MappedMatrix(path).Verify());
+  ASSERT_THROW(S21MappedMatrix(path, true), std::runtime_error);
+  std::remove(path.c_str());
+  ASSERT_THROW(s21::Load<double>(path), std::runtime_error);
+  ASSERT_THROW(S21MappedMatrix{path}, std::system_error);
+}
+
+TEST(Test_MatrixIO, Stream_1) {
+  S21MatrixI64 A(5, 9);
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 9; j++) {
+      A(i, j) = (std::int64_t(1) << 40) * (i - 2) + j;
+    }
+  }
+  std::stringstream stream;
+  s21::Save(A, stream);
+  s21::Save(S21MatrixF(), stream);
+  ASSERT_TRUE(s21::Load<std::int64_t>(stream) == A);
+  ASSERT_EQ(s21::Load<float>(stream).GetRows(), 0);
+
+  std::stringstream truncated(stream.str().substr(0, 100));
+  ASSERT_THROW(s21::Load<std::int64_t>(truncated), std::runtime_error);
+  std::stringstream garbage("not a matrix file, just some text to fill 64b");
+  garbage.seekp(0, std::ios::end);
+  garbage << std::string(64, ' ');
+  ASSERT_THROW(s21::Load<double>(garbage), std::invalid_argument);
+}
+
+TEST(Test_MatrixIO, CorruptedHeader_1) {
+  // rows * stride * 16 = 2^64 - без проверки размер данных был бы 0
+  const std::string path = "test.s21m";
+  s21::Save(S21MatrixLD(1, 1), path);
+  s21::MatrixFileHeader header;
+  {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    header.rows = header.stride = std::int64_t(1) << 30;
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  }
+  ASSERT_THROW(s21::Load<long double>(path), std::runtime_error);
+  ASSERT_THROW(S21MappedMatrixT<long double>{path}, std::runtime_error);
+  {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    header.rows = header.stride = 1;
+    header.data_offset = ~std::uint64_t(0) - 63;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  }
+  ASSERT_THROW(s21::Load<long double>(path), std::runtime_error);
+  ASSERT_THROW(S21MappedMatrixT<long double>{path}, std::runtime_error);
+  std::remove(path.c_str());
+}
+
+TEST(Test_Tiled, Operations_1) {
+  S21Matrix A(45, 30), B(30, 21), C(45, 30);
+  FillPattern(A, 9);
+  FillPattern(B, 10);
+  FillPattern(C, 11);
+  S21TiledMatrix a("test.a.s21t", 45, 30, 8);
+  S21TiledMatrix b("test.b.s21t", 30, 21, 8);
+  ASSERT_EQ(a.GetTileRows(), 6);
+  ASSERT_EQ(a.GetTileCols(), 4);
+  a.SetBlock(0, 0, A);
+  b.SetBlock(0, 0, B);
+  ASSERT_TRUE(a.ToMatrix() == A);
+  S21Matrix block = a.GetBlock(5, 7, 20, 11);
+  ASSERT_EQ(block(0, 0), A(5, 7));
+  ASSERT_EQ(block(19, 10), A(24, 17));
+
+  // Бюджет на 5 плиток - по одной плитке C за раз
+  const std::size_t tile_bytes = 8 * 8 * sizeof(double);
+  for (std::size_t budget : {5 * tile_bytes, s21::kOutOfCoreBudget}) {
+    S21TiledMatrix product = a.MulMatrix(b, "test.c.s21t", budget);
+    ASSERT_TRUE(product.ToMatrix() == NaiveMul(A, B));
+    S21TiledMatrix transposed = a.Transpose("test.c.s21t", budget);
+    ASSERT_TRUE(transposed.ToMatrix() == A.Transpose());
+  }
+  ASSERT_THROW(a.MulMatrix(b, "test.c.s21t", 4 * tile_bytes),
+               std::invalid_argument);
+  ASSERT_THROW(a.MulMatrix(a, "test.c.s21t"), std::invalid_argument);
+  // Результат в файл операнда обнулил бы его до чтения
+  ASSERT_THROW(a.MulMatrix(b, a.GetPath()), std::invalid_argument);
+  ASSERT_THROW(a.MulMatrix(b, "./test.b.s21t"), std::invalid_argument);
+  ASSERT_THROW(a.Transpose("./test.a.s21t"), std::invalid_argument);
+  ASSERT_TRUE(a.ToMatrix() == A);
+  ASSERT_TRUE(b.ToMatrix() == B);
+
+  S21TiledMatrix c("test.c.s21t", 45, 30, 8);
+  c.SetBlock(0, 0, C);
+  a.SumMatrix(c, 4 * tile_bytes);
+  ASSERT_TRUE(S21TiledMatrix("test.a.s21t").ToMatrix() == A + C);
+  ASSERT_THROW(a.SumMatrix(b), std::out_of_range);
+  ASSERT_THROW(a.GetBlock(40, 0, 6, 1), std::out_of_range);
+  ASSERT_THROW(S21TiledMatrixT<float>{"test.a.s21t"}, std::invalid_argument);
+  std::remove("test.a.s21t");
+  std::remove("test.b.s21t");
+  std::remove("test.c.s21t");
+}
+
+TEST(Test_Tiled, CorruptedHeader_1) {
+  const std::string path = "test.s21t";
+  { S21TiledMatrixT<long double> created(path, 3, 3, 2); }
+  s21::MatrixFileHeader header;
+  {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    // Плитка (2^31 - 1)^2 * 16 байт не помещается в off_t
+    header.rows = header.cols = header.stride = INT_MAX;
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  }
+  ASSERT_THROW(S21TiledMatrixT<long double>{path}, std::runtime_error);
+  {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    // 2^62 плиток по одному элементу - больше INT_MAX
+    header.stride = 1;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  }
+  ASSERT_THROW(S21TiledMatrixT<long double>{path}, std::runtime_error);
+  ASSERT_THROW(S21TiledMatrix(path, INT_MAX, INT_MAX, 1), std::length_error);
+  std::remove(path.c_str());
+}
+
+TEST(Test_Tiled, Import_1) {
+  S21Matrix A(37, 23);
+  FillPattern(A, 12);
+  s21::Save(A, "test.s21m");
+  S21TiledMatrix tiled =
+      S21TiledMatrix::Import(S21MappedMatrix("test.s21m"), "test.s21t", 16);
+  ASSERT_TRUE(tiled.ToMatrix() == A);
+  ASSERT_THROW(S21TiledMatrix{"test.s21m"}, std::invalid_argument);
+  std::remove("test.s21m");
+  std::remove("test.s21t");
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
 